@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "backend.h"
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTest>
+
+class BackendTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void announcesBackendsAfterConstruction();
+};
+
+void BackendTest::initTestCase()
+{
+    // Backend keeps caches and snapshots, keep them away from the user's
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void BackendTest::announcesBackendsAfterConstruction()
+{
+    // Detection may finish right away on native builds, the signal must still reach
+    // whoever connects after the constructor returned, as MainWindow does
+    Backend backend;
+    QSignalSpy spy(&backend, &Backend::availableBackendsChanged);
+    QVERIFY(spy.isValid());
+
+    QVERIFY(spy.wait(10000));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.first().first().toStringList(), backend.availableBackends());
+}
+
+QTEST_MAIN(BackendTest)
+
+#include "backendtest.moc"
@@ -0,0 +1,487 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "commandrunner.h"
+#include "containerlistparser.h"
+#include "distroclassifier.h"
+#include "distrotable.h"
+#include "hostspawnserver.h"
+#include "imagesearch.h"
+#include "packagemanager.h"
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+#include <memory>
+
+// Hot paths of listing containers and browsing images, on the recorded
+// outputs in data/ and on synthetic lists of 10 to 10,000 entries built from them,
+// and the cost of running host commands with and without the spawn server.
+class KontainerBench : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void parseRuntimeJson_data();
+    void parseRuntimeJson();
+    void parseDistroboxTable_data();
+    void parseDistroboxTable();
+    void parseToolboxTable_data();
+    void parseToolboxTable();
+    void parseRuntimeEvents_data();
+    void parseRuntimeEvents();
+
+    void classifyImage_data();
+    void classifyImage();
+    void distroIcon_data();
+    void distroIcon();
+    void packageFamily_data();
+    void packageFamily();
+
+    void searchImages_data();
+    void searchImages();
+    void searchIndex_data();
+    void searchIndex();
+
+    void spawnCommands_data();
+    void spawnCommands();
+
+private:
+    static QString readData(const QString &name);
+    // Recorded lines repeated until there are count of them, each with its own ID
+    static QStringList scaledRows(const QStringList &rows, int count);
+    // Recorded image references followed by mirrored copies, all distinct
+    QStringList scaledImages(int count) const;
+    ImageList imageCatalog(int count) const;
+    // Starts count commands at once and returns how many succeeded once all finished
+    static int runCommands(CommandRunner *runner, const QStringList &command, int count);
+
+    QJsonArray m_podmanContainers;
+    QStringList m_dockerLines;
+    QStringList m_distroboxTable;
+    QStringList m_toolboxTable;
+    QStringList m_images;
+};
+
+static const QList<int> SIZES = {10, 100, 1000, 10000};
+// Every direct command is a process of its own, thousands would only measure fork()
+static const QList<int> COMMAND_COUNTS = {1, 10, 100};
+// Stands in for flatpak-spawn --host: one extra exec on the way to the command
+static const QStringList LAUNCHER = {"sh", "-c", "exec \"$@\"", "sh"};
+
+QString KontainerBench::readData(const QString &name)
+{
+    QFile file(QStringLiteral(BENCH_DATA_DIR "/") + name);
+    if (!file.open(QIODevice::ReadOnly))
+        qFatal("Missing benchmark data %s", qPrintable(file.fileName()));
+    return QString::fromUtf8(file.readAll());
+}
+
+QStringList KontainerBench::scaledRows(const QStringList &rows, int count)
+{
+    QStringList scaled;
+    scaled.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        // The first column is the ID, the second the name in both table formats
+        QString row = rows.at(i % rows.size());
+        const QString suffix = QString::number(i);
+        row.replace(0, suffix.size(), suffix);
+        scaled << row;
+    }
+    return scaled;
+}
+
+QStringList KontainerBench::scaledImages(int count) const
+{
+    QStringList images;
+    images.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString &image = m_images.at(i % m_images.size());
+        images << (i < m_images.size() ? image : QStringLiteral("mirror%1.example.org/").arg(i / m_images.size()) + image.section('/', 1));
+    }
+    return images;
+}
+
+ImageList KontainerBench::imageCatalog(int count) const
+{
+    ImageList catalog;
+    catalog.reserve(count);
+    for (const QString &url : scaledImages(count)) {
+        ImageInfo image;
+        const QString distro = DistroClassifier::classify(url);
+        image.url = url;
+        image.name = url.split('/').last();
+        image.distro = InternedString(distro);
+        image.icon = InternedString(DistroTable::iconPath(distro));
+        image.display = url;
+        catalog << image;
+    }
+    return catalog;
+}
+
+void KontainerBench::initTestCase()
+{
+    m_podmanContainers = QJsonDocument::fromJson(readData(QStringLiteral("podman-ps.json")).toUtf8()).array();
+    m_dockerLines = readData(QStringLiteral("docker-ps.jsonl")).split('\n', Qt::SkipEmptyParts);
+    m_distroboxTable = readData(QStringLiteral("distrobox-list.txt")).split('\n', Qt::SkipEmptyParts);
+    m_toolboxTable = readData(QStringLiteral("toolbox-list.txt")).split('\n', Qt::SkipEmptyParts);
+    m_images = readData(QStringLiteral("distrobox-images.txt")).split('\n', Qt::SkipEmptyParts);
+
+    QVERIFY(!m_podmanContainers.isEmpty());
+    QVERIFY(!m_dockerLines.isEmpty());
+    QVERIFY(m_distroboxTable.size() > 1);
+    QVERIFY(m_toolboxTable.size() > 1);
+    QVERIFY(!m_images.isEmpty());
+}
+
+void KontainerBench::parseRuntimeJson_data()
+{
+    QTest::addColumn<QString>("output");
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("podman recorded") << readData(QStringLiteral("podman-ps.json")) << int(m_podmanContainers.size());
+    QTest::newRow("docker recorded") << m_dockerLines.join('\n') << int(m_dockerLines.size());
+
+    for (const int size : SIZES) {
+        QJsonArray podman;
+        for (int i = 0; i < size; ++i) {
+            QJsonObject container = m_podmanContainers.at(i % m_podmanContainers.size()).toObject();
+            container.insert("Id", QStringLiteral("%1").arg(i, 64, 16, QLatin1Char('0')));
+            container.insert("Names", QJsonArray{QStringLiteral("container-%1").arg(i)});
+            podman << container;
+        }
+        QTest::addRow("podman %d", size) << QString::fromUtf8(QJsonDocument(podman).toJson(QJsonDocument::Compact)) << size;
+
+        QStringList docker;
+        for (int i = 0; i < size; ++i) {
+            QJsonObject container = QJsonDocument::fromJson(m_dockerLines.at(i % m_dockerLines.size()).toUtf8()).object();
+            container.insert("ID", QStringLiteral("%1").arg(i, 12, 16, QLatin1Char('0')));
+            container.insert("Names", QStringLiteral("container-%1").arg(i));
+            docker << QString::fromUtf8(QJsonDocument(container).toJson(QJsonDocument::Compact));
+        }
+        QTest::addRow("docker %d", size) << docker.join('\n') << size;
+    }
+}
+
+void KontainerBench::parseRuntimeJson()
+{
+    QFETCH(QString, output);
+    QFETCH(int, count);
+
+    ContainerList containers;
+    bool ok = false;
+    QBENCHMARK {
+        containers = ContainerListParser::parseRuntimeJson(output, &ok);
+    }
+    QVERIFY(ok);
+    QCOMPARE(containers.size(), qsizetype(count));
+}
+
+void KontainerBench::parseDistroboxTable_data()
+{
+    QTest::addColumn<QString>("output");
+    QTest::addColumn<int>("count");
+
+    const QString header = m_distroboxTable.first();
+    const QStringList rows = m_distroboxTable.mid(1);
+    QTest::newRow("recorded") << m_distroboxTable.join('\n') << int(rows.size());
+    for (const int size : SIZES) {
+        QTest::addRow("%d", size) << (QStringList{header} + scaledRows(rows, size)).join('\n') << size;
+    }
+}
+
+void KontainerBench::parseDistroboxTable()
+{
+    QFETCH(QString, output);
+    QFETCH(int, count);
+
+    ContainerList containers;
+    QBENCHMARK {
+        containers = ContainerListParser::parseDistroboxTable(output);
+    }
+    QCOMPARE(containers.size(), qsizetype(count));
+}
+
+void KontainerBench::parseToolboxTable_data()
+{
+    QTest::addColumn<QString>("output");
+    QTest::addColumn<int>("count");
+
+    const QString header = m_toolboxTable.first();
+    const QStringList rows = m_toolboxTable.mid(1);
+    QTest::newRow("recorded") << m_toolboxTable.join('\n') << int(rows.size());
+    for (const int size : SIZES) {
+        QTest::addRow("%d", size) << (QStringList{header} + scaledRows(rows, size)).join('\n') << size;
+    }
+}
+
+void KontainerBench::parseToolboxTable()
+{
+    QFETCH(QString, output);
+    QFETCH(int, count);
+
+    ContainerList containers;
+    QBENCHMARK {
+        containers = ContainerListParser::parseToolboxTable(output);
+    }
+    QCOMPARE(containers.size(), qsizetype(count));
+}
+
+void KontainerBench::parseRuntimeEvents_data()
+{
+    QTest::addColumn<QStringList>("lines");
+    QTest::addColumn<QStringList>("actions");
+
+    // kill is dropped, docker's die and destroy arrive as podman's died and remove
+    const QStringList podman = readData(QStringLiteral("podman-events.jsonl")).split('\n', Qt::SkipEmptyParts);
+    const QStringList podmanActions = {"create", "start", "died", "died", "remove"};
+    const QStringList docker = readData(QStringLiteral("docker-events.jsonl")).split('\n', Qt::SkipEmptyParts);
+    const QStringList dockerActions = {"create", "start", "died", "stop", "remove"};
+    QTest::newRow("podman recorded") << podman << podmanActions;
+    QTest::newRow("docker recorded") << docker << dockerActions;
+
+    // The recorded lifecycle again and again, as a busy event stream delivers it
+    for (const int size : SIZES) {
+        QStringList lines;
+        QStringList actions;
+        for (int i = 0; lines.size() < size; ++i) {
+            lines += (i % 2 ? docker : podman);
+            actions += (i % 2 ? dockerActions : podmanActions);
+        }
+        QTest::addRow("%d", size) << lines << actions;
+    }
+}
+
+void KontainerBench::parseRuntimeEvents()
+{
+    QFETCH(QStringList, lines);
+    QFETCH(QStringList, actions);
+
+    QStringList parsed;
+    QBENCHMARK {
+        parsed.clear();
+        for (const QString &line : std::as_const(lines)) {
+            ContainerInfo container;
+            const QString action = ContainerListParser::parseRuntimeEvent(QJsonDocument::fromJson(line.toUtf8()).object(), &container);
+            if (!action.isEmpty())
+                parsed << action;
+        }
+    }
+    QCOMPARE(parsed, actions);
+}
+
+void KontainerBench::classifyImage_data()
+{
+    QTest::addColumn<QStringList>("images");
+
+    // The catalog again and again, as on every refresh
+    QTest::newRow("recorded, memoized") << m_images;
+    // Only the largest set outgrows the classifier's memo and keeps missing it
+    for (const int size : SIZES) {
+        QTest::addRow("%d distinct", size) << scaledImages(size);
+    }
+}
+
+void KontainerBench::classifyImage()
+{
+    QFETCH(QStringList, images);
+
+    int unknown = 0;
+    QBENCHMARK {
+        unknown = 0;
+        for (const QString &image : std::as_const(images)) {
+            unknown += DistroClassifier::classify(image) == QLatin1String("unknown");
+        }
+    }
+    QVERIFY(unknown < images.size());
+}
+
+void KontainerBench::distroIcon_data()
+{
+    QTest::addColumn<QStringList>("distros");
+
+    QStringList distros;
+    for (const QString &image : std::as_const(m_images)) {
+        distros << DistroClassifier::classify(image);
+    }
+    QTest::newRow("recorded") << distros;
+
+    // Exact names, names with a suffix that need the substring match, and misses
+    for (const int size : SIZES) {
+        QStringList scaled;
+        for (int i = 0; i < size; ++i) {
+            const QString &distro = distros.at(i % distros.size());
+            switch (i % 3) {
+            case 0:
+                scaled << distro;
+                break;
+            case 1:
+                scaled << distro + QStringLiteral("-custom");
+                break;
+            default:
+                scaled << QStringLiteral("homegrown%1").arg(i);
+                break;
+            }
+        }
+        QTest::addRow("%d", size) << scaled;
+    }
+}
+
+void KontainerBench::distroIcon()
+{
+    QFETCH(QStringList, distros);
+
+    qsizetype length = 0;
+    QBENCHMARK {
+        length = 0;
+        for (const QString &distro : std::as_const(distros)) {
+            length += DistroTable::iconPath(distro).size();
+        }
+    }
+    QVERIFY(length > 0);
+}
+
+void KontainerBench::packageFamily_data()
+{
+    QTest::addColumn<QStringList>("images");
+
+    QTest::newRow("recorded") << m_images;
+    for (const int size : SIZES) {
+        QTest::addRow("%d", size) << scaledImages(size);
+    }
+}
+
+void KontainerBench::packageFamily()
+{
+    QFETCH(QStringList, images);
+
+    int known = 0;
+    QBENCHMARK {
+        known = 0;
+        for (const QString &image : std::as_const(images)) {
+            known += !PackageManager::getDistroFromImage(image).isEmpty();
+        }
+    }
+    QVERIFY(known > 0);
+}
+
+void KontainerBench::searchImages_data()
+{
+    QTest::addColumn<ImageList>("catalog");
+    QTest::addColumn<QString>("query");
+
+    const QStringList queries = {QStringLiteral("fedora"), QStringLiteral("Toolbox"), QStringLiteral("no-such-image")};
+    for (const QString &query : queries) {
+        QTest::addRow("recorded, %s", qPrintable(query)) << imageCatalog(m_images.size()) << query;
+    }
+    for (const int size : SIZES) {
+        const ImageList catalog = imageCatalog(size);
+        for (const QString &query : queries) {
+            QTest::addRow("%d, %s", size, qPrintable(query)) << catalog << query;
+        }
+    }
+}
+
+void KontainerBench::searchImages()
+{
+    QFETCH(ImageList, catalog);
+    QFETCH(QString, query);
+
+    ImageList found;
+    QBENCHMARK {
+        found = ImageSearch::filter(catalog, query);
+    }
+    QVERIFY(found.size() <= catalog.size());
+}
+
+void KontainerBench::searchIndex_data()
+{
+    searchImages_data();
+}
+
+void KontainerBench::searchIndex()
+{
+    QFETCH(ImageList, catalog);
+    QFETCH(QString, query);
+
+    const ImageSearchIndex index(catalog);
+    const qsizetype expected = ImageSearch::filter(catalog, query).size();
+
+    // One keystroke at a time, every query narrowing the previous result
+    QList<int> rows;
+    QBENCHMARK {
+        rows = index.search(QString());
+        for (qsizetype length = 1; length <= query.size(); ++length) {
+            const QList<int> previous = rows;
+            rows = index.search(query.left(length), length > 1 ? &previous : nullptr);
+        }
+    }
+
+    // Same matches as the plain filter, only ranked
+    QCOMPARE(rows.size(), expected);
+}
+
+int KontainerBench::runCommands(CommandRunner *runner, const QStringList &command, int count)
+{
+    QEventLoop loop;
+    int pending = count;
+    int succeeded = 0;
+    for (int i = 0; i < count; ++i) {
+        runner->run(command).then(&loop, [&loop, &pending, &succeeded](const CommandResult &result) {
+            succeeded += result.success();
+            if (--pending == 0)
+                loop.quit();
+        });
+    }
+    // Commands start from the event loop, none can have finished yet
+    loop.exec();
+    return succeeded;
+}
+
+void KontainerBench::spawnCommands_data()
+{
+    QTest::addColumn<bool>("multiplexed");
+    QTest::addColumn<int>("count");
+
+    for (const int count : COMMAND_COUNTS) {
+        QTest::addRow("direct %d", count) << false << count;
+        QTest::addRow("spawn server %d", count) << true << count;
+    }
+}
+
+void KontainerBench::spawnCommands()
+{
+    QFETCH(bool, multiplexed);
+    QFETCH(int, count);
+
+    // Direct commands carry the launcher themselves, as hostCommand() adds flatpak-spawn
+    CommandRunner runner(false);
+    std::unique_ptr<HostSpawnServer> server;
+    QStringList command = {"true"};
+    if (multiplexed) {
+        server = std::make_unique<HostSpawnServer>(LAUNCHER);
+        runner.setHostSpawnServer(server.get());
+    } else {
+        command = LAUNCHER + command;
+    }
+
+    // The helper starts once per session, not once per batch
+    QCOMPARE(runCommands(&runner, command, 1), 1);
+
+    int succeeded = 0;
+    QBENCHMARK {
+        succeeded = runCommands(&runner, command, count);
+    }
+    QCOMPARE(succeeded, count);
+    // A helper that failed to start would have run everything directly
+    if (server)
+        QVERIFY(server->isAvailable());
+}
+
+QTEST_GUILESS_MAIN(KontainerBench)
+
+#include "kontainerbench.moc"
@@ -3,62 +3,109 @@
 
 #pragma once
 
+#include "commandrunner.h"
+#include "containerinfo.h"
+#include "containerosreleasecache.h"
+#include "containersizecache.h"
+#include "containerstatssampler.h"
+#include "imagecatalog.h"
+#include "localimageinventory.h"
+#include "containercreationjob.h"
+#include "containereventwatcher.h"
+#include "jobscheduler.h"
+#include <KConfigGroup>
 #include <KLocalizedString>
+#include <KSharedConfig>
 #include <KTerminalLauncherJob>
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFileInfo>
+#include <QFileSystemWatcher>
 #include <QFuture>
+#include <QHash>
 #include <QMap>
 #include <QObject>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QSet>
 #include <QStandardPaths>
 #include <QString>
 #include <QStringList>
+#include <QTimer>
 #include <QtConcurrent/QtConcurrent>
 #include <algorithm>
-#include <QMutex>
-#include <QMutexLocker>
+#include <functional>
 
 class Backend : public QObject
 {
     Q_OBJECT
 public:
     explicit Backend(QObject *parent = nullptr);
+    ~Backend() override;
     QStringList availableBackends() const;
     void setPreferredBackend(const QString &backend);
     bool isTerminalJobPossible();
 
     // Container operations
-    QString
-    createContainer(const QString &name, const QString &image, const QString &home = QString(), bool init = false, const QStringList &volumes = QStringList());
+    // Returns the not yet started creation job, or nullptr without a usable backend.
+    // Cancelling it removes the partially created container.
+    ContainerCreationJob *createContainer(const QString &name,
+                                          const QString &image,
+                                          const QString &home = QString(),
+                                          bool init = false,
+                                          const QStringList &volumes = QStringList());
+    // podman, or docker when distrobox has nothing else to use
+    QString containerManager() const;
+    // Whether changes of every listed backend currently arrive through the runtime's event stream
+    bool isWatchingContainers() const;
+    // Containers of the preferred backend as they were when last seen, possibly stale.
+    // Empty if there is no usable snapshot, callers should still fetch the live list.
+    ContainerList loadContainerSnapshot();
     void deleteContainer(const QString &name);
     void enterContainer(const QString &name);
     void upgradeContainer(const QString &name);
     void upgradeAllContainers();
     void executeInTerminal(const QString &command);
-    void installDebPackageNoTerminal(const QString &containerName, const QString &filePath);
-    void installRpmPackageNoTerminal(const QString &containerName, const QString &filePath);
-    void installArchPackageNoTerminal(const QString &containerName, const QString &filePath);
-    void upgradeContainerNoTerminal(const QString &containerName);
-    void upgradeAllContainersNoTerminal();
+    // No-terminal operations are queued per container and return the job id, or 0 on error
+    quint64 installDebPackageNoTerminal(const QString &containerName, const QString &filePath);
+    quint64 installRpmPackageNoTerminal(const QString &containerName, const QString &filePath);
+    quint64 installArchPackageNoTerminal(const QString &containerName, const QString &filePath);
+    quint64 upgradeContainerNoTerminal(const QString &containerName);
+    // One job per known distrobox container, or a single distrobox-upgrade --all job
+    QList<quint64> upgradeAllContainersNoTerminal();
+    JobScheduler *jobScheduler() const;
+    // Resource usage of the running containers in the current list
+    ContainerStatsSampler *statsSampler() const;
+    // Disk usage of the listed containers, measured in the background
+    ContainerSizeCache *containerSizes() const;
     // App operations
-    QStringList getAvailableApps(const QString &containerName);
+    QFuture<QStringList> getAvailableApps(const QString &containerName);
     QStringList getExportedApps(const QString &containerName);
-    QString exportApp(const QString &appName, const QString &containerName);
-    QString unexportApp(const QString &appName, const QString &containerName);
+    QFuture<QString> exportApp(const QString &appName, const QString &containerName);
+    QFuture<QString> unexportApp(const QString &appName, const QString &containerName);
     QString getContainerDistro(const QString &containerName) const;
+    // Backend new containers are created with
     QString preferredBackend() const;
+    // Backend a listed container belongs to, operations on it go there
+    QString backendFor(const QString &containerName) const;
+
+    // Lists the containers of every available backend instead of the preferred one only
+    static inline const QString AllBackends = QStringLiteral("all");
+    // AllBackends or the preferred backend
+    QString containerFilter() const;
+    // Shows the cached containers of the new selection right away, fetchContainersAsync() revalidates them
+    void setContainerFilter(const QString &filter);
     void checkTerminaljob();
 
     // Image operations
-    QList<QMap<QString, QString>> getAvailableImages();
-    QList<QMap<QString, QString>> searchImages(const QString &query);
+    // The catalog merged with the local images, those flagged local and listed first.
+    // reload lists both again instead of answering from the caches.
+    QFuture<ImageList> getAvailableImages(bool reload = false);
 
 signals:
-    void assembleStartedWithDialog();           // For UI to open dialog
-    void assembleFinished(const QString &output); // Called on each output line or on finish
+    void assembleFinished(const QString &output);
     void debInstallFinished(const QString &output);
     void rpmInstallFinished(const QString &output);
     void archInstallFinished(const QString &output);
@@ -66,23 +113,41 @@ signals:
     void upgradeAllFinished(const QString &output);
     void packageInstallFinished(const QString &signalName, const QString &result);
     void outputReceived(const QString &output);
-    void containerCreationStarted();
-    void containerOutput(const QString &output);
-    void containerCreationFinished(bool success, const QString &message);
     void availableBackendsChanged(const QStringList &backends);
-    void containersFetched(const QList<QMap<QString, QString>> &containers);
+    void containersFetched(const ContainerList &containers);
     void terminalFinished();
+    void terminalAvailabilityChanged(bool possible);
 
 public slots:
-    void assembleContainer(const QString &iniFile);
+    // Returns the queued job id, or 0 when it was started in a terminal
+    quint64 assembleContainer(const QString &iniFile);
     void installDebPackage(const QString &containerName, const QString &filePath);
     void installRpmPackage(const QString &containerName, const QString &filePath);
     void installArchPackage(const QString &containerName, const QString &filePath);
     void fetchContainersAsync();
 
 private:
-    QString resolveBinaryPath(const QString &binary);
-    QString runCommand(const QStringList &command) const;
+    QFuture<QString> resolveBinaryPath(const QString &binary);
+    QFuture<void> refreshBinaryCache(const QStringList &binaries);
+    bool lookupBinaryCache(const QString &binary, QString *path);
+    QFuture<QString> runCommand(const QStringList &command) const;
+    using JobCallback = std::function<void(const QString &output, const CommandResult &result)>;
+    quint64 runQueued(const QString &containerName, const QString &title, const QStringList &command, const JobCallback &onFinished, const QString &group = QString());
+    void removePartialContainer(const QString &name);
+    QString containerManager(const QString &backend) const;
+    QStringList listedBackends() const;
+    ContainerList visibleContainers() const;
+    const ContainerInfo *findContainer(const QString &containerName) const;
+    ContainerEventWatcher *eventWatcher(const QString &backend);
+    void fetchBackendContainers(const QString &backend);
+    void fetchContainersFromTable(const QString &backend);
+    void storeBackendContainers(const QString &backend, const ContainerList &containers);
+    QString containerSnapshotPath() const;
+    void saveContainerSnapshot();
+    void refreshUnlessWatched();
+    void applyContainerEvent(const QString &backend, const QString &action, const ContainerInfo &event);
+    ContainerList finishContainerList(ContainerList containers, const QString &backend) const;
+    void applyOsReleases(const QStringList &ids);
     QString parseDistroFromImage(const QString &imageUrl) const;
     QString getDistroIcon(const QString &distroName) const;
     bool m_isFlatpak = false;
@@ -90,72 +155,51 @@ private:
     void checkAvailableBackends();
     void validatePreferredBackend();
     QString getDistroFromToolboxImage(const QString &image) const;
-    void installPackageNoTerminal(const QString &containerName, const QString &filePath, const QString &packageCommand, const QString &signalName);
-    void handlePackageInstallFinished(QProcess *process, int exitCode, const QString &signalName);
+    QFuture<ImageList> mergeLocalImages(QFuture<ImageList> catalog);
+    quint64 installPackageNoTerminal(const QString &containerName, const QString &filePath, const QString &packageCommand, const QString &signalName);
     QStringList buildToolboxCommand(const QString &containerName, const QString &command);
     QStringList buildDistroboxCommand(const QString &containerName, const QString &command);
-    QProcess *m_createProcess = nullptr;
-    QStringList m_cachedBackends;
-    QList<QMap<QString, QString>> m_currentContainers;
-    bool m_isTerminalJobPossible;
-    QMutex mutex;
-
-    const QStringList DISTROS = {"alma",     "alpine",     "amazon", "amazonlinux", "arch",       "bazzite",   "blackarch",   "bluefin",  "bookworm",
-                                 "bullseye", "buster",     "centos", "chainguard",  "clearlinux", "crystal",   "debian",      "deepin",   "fedora",
-                                 "gentoo",   "kali",       "leap",   "linuxmint",   "mageia",     "neon",      "neurodebian", "opensuse", "oracle",
-                                 "plasma",   "powershell", "redhat", "rhel",        "rocky",      "slackware", "steamos",     "toolbox",  "tumbleweed",
-                                 "ubi",      "ublue",      "ubuntu", "vanilla",     "vso",        "void",      "wheezy",      "wolfi"};
+    void executeResolvedInTerminal(const QString &binary, const QString &arguments);
+    QString writeToolboxDesktopFile(const QString &appName, const QString &containerName, const QString &desktopFile, const QString &desktopContent);
 
-    QMap<QString, QString> distroIconMap = {// Official distros
-                                            {"alma", "almalinux.svg"},
-                                            {"alpine", "alpine.svg"},
-                                            {"amazon", "amazonlinux.svg"},
-                                            {"amazonlinux", "amazonlinux.svg"},
-                                            {"arch", "archlinux.svg"},
-                                            {"blackarch", "blackarchlinux.svg"},
-                                            {"centos", "centos.svg"},
-                                            {"clearlinux", "clearlinux.svg"},
-                                            {"debian", "debian.svg"},
-                                            {"deepin", "deepin.svg"},
-                                            {"fedora", "fedora.svg"},
-                                            {"gentoo", "gentoo.svg"},
-                                            {"kali", "kali-linux.svg"},
-                                            {"linuxmint", "linuxmint.svg"},
-                                            {"mageia", "mageia.svg"},
-                                            {"neon", "kde-neon.svg"},
-                                            {"neurodebian", "debian.svg"},
-                                            {"opensuse", "opensuse.svg"},
-                                            {"oracle", "oracle.svg"},
-                                            {"redhat", "redhat.svg"},
-                                            {"rhel", "redhat.svg"},
-                                            {"rocky", "rocky-linux.svg"},
-                                            {"slackware", "slackware.svg"},
-                                            {"steamos", "steamos.svg"},
-                                            {"ubuntu", "ubuntu.svg"},
-                                            {"vanilla", "vanilla.svg"},
-                                            {"vso", "vanilla.svg"},
-                                            {"void", "void.svg"},
-                                            {"wolfi", "wolfi.svg"},
+    struct ResolvedBinary {
+        QString path;
+        qint64 mtime = -1;
+    };
 
-                                            // Variants and derivatives
-                                            {"bazzite", "bazzite.svg"},
-                                            {"bluefin", "ublue.svg"},
-                                            {"bullseye", "debian.svg"},
-                                            {"buster", "debian.svg"},
-                                            {"bookworm", "debian.svg"},
-                                            {"leap", "opensuse.svg"},
-                                            {"tumbleweed", "tumbleweed.svg"},
-                                            {"plasma", "kde-neon.svg"},
-                                            {"powershell", "tux.svg"}, // Generic icon
-                                            {"toolbox", "tux.svg"}, // Generic icon
-                                            {"ubi", "redhat.svg"}, // Red Hat Universal Base Image
-                                            {"neurodebian", "debian.svg"},
-
-                                            // Cloud/container specific
-                                            {"chainguard", "tux.svg"},
-                                            {"ublue", "ublue.svg"}, // Could use fedora.svg or create custom
-                                            {"crystal", "crystal.svg"},
+    CommandRunner *m_runner = nullptr;
+    // Resolved binary locations, valid as long as PATH and the binaries' mtimes do not change
+    QHash<QString, ResolvedBinary> m_binaryCache;
+    QString m_binaryCachePath;
+    QElapsedTimer m_binaryCacheAge;
+    bool m_binaryCacheRefreshing = false;
+    static constexpr qint64 BINARY_CACHE_REVALIDATE_MS = 30000;
+    const QStringList KNOWN_BINARIES = {"distrobox", "distrobox-assemble", "distrobox-upgrade", "toolbox", "podman", "docker"};
+    QStringList m_cachedBackends;
+    // Last known containers of each backend, also of those not listed right now
+    QHash<QString, ContainerList> m_containersByBackend;
+    bool m_listAllBackends = false;
+    // Container managers that turned out not to support JSON listings
+    QSet<QString> m_jsonUnsupportedManagers;
+    QHash<QString, ContainerEventWatcher *> m_eventWatchers;
+    QTimer *m_eventFlushTimer = nullptr;
+    QTimer *m_snapshotTimer = nullptr;
+    static constexpr quint32 SNAPSHOT_MAGIC = 0x4b435331; // "KCS1"
+    static constexpr quint16 SNAPSHOT_VERSION = 3;
+    QString currentTerminalConfiguration() const;
+    void watchTerminalConfig();
+    void handleTerminalConfigChanged();
 
-                                            // Default fallbacks
-                                            {"unknown", "tux.svg"}};
+    // Cached result of the terminal probe and the inputs it was computed from
+    bool m_isTerminalJobPossible = false;
+    bool m_terminalProbeNoTerminal = false;
+    QString m_terminalConfiguration;
+    QFileSystemWatcher *m_terminalConfigWatcher = nullptr;
+    JobScheduler *m_jobScheduler = nullptr;
+    ContainerStatsSampler *m_statsSampler = nullptr;
+    ContainerSizeCache *m_sizeCache = nullptr;
+    ContainerOsReleaseCache *m_osReleases = nullptr;
+    ImageCatalog *m_imageCatalog = nullptr;
+    LocalImageInventory *m_localImages = nullptr;
+    QHash<quint64, JobCallback> m_jobCallbacks;
 };
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <functional>
+#include <memory>
+
+// Shared cancellation flag handed to long-running operations. Copies refer to
+// the same state, so the UI keeps one copy and the operation another.
+class CancellationToken
+{
+public:
+    CancellationToken();
+
+    void cancel() const;
+    bool isCancelled() const;
+
+    // Runs callback once the token is cancelled, right away if it already is.
+    // The callback is dropped when context is destroyed first.
+    void onCancelled(QObject *context, const std::function<void()> &callback) const;
+
+private:
+    struct State {
+        bool cancelled = false;
+        QList<std::pair<QPointer<QObject>, std::function<void()>>> callbacks;
+    };
+    std::shared_ptr<State> d;
+};
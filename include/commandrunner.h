@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "cancellationtoken.h"
+#include <QFuture>
+#include <QObject>
+#include <QPointer>
+#include <QProcess>
+#include <QPromise>
+#include <QString>
+#include <QStringDecoder>
+#include <QStringList>
+#include <QTimer>
+
+// Outcome of a finished command
+struct CommandResult {
+    QStringList command;
+    int exitCode = -1;
+    QProcess::ExitStatus exitStatus = QProcess::NormalExit;
+    bool started = false;
+    bool timedOut = false;
+    bool cancelled = false;
+    QString standardOutput;
+    QString standardError;
+    // Set when standardOutput only holds the tail kept by an OutputSink
+    bool outputTruncated = false;
+
+    bool success() const
+    {
+        return started && !timedOut && !cancelled && exitStatus == QProcess::NormalExit && exitCode == 0;
+    }
+};
+Q_DECLARE_METATYPE(CommandResult)
+
+class HostSpawnServer;
+class OutputSink;
+
+// A single running command. Output is streamed through outputReceived() while
+// the process runs and the complete result is delivered through finished() and
+// future(). Jobs delete themselves once finished.
+class CommandJob : public QObject
+{
+    Q_OBJECT
+public:
+    QStringList command() const;
+    QFuture<CommandResult> future();
+    bool isFinished() const;
+    // Streams standard output into sink instead of collecting all of it in memory,
+    // the result then only carries the sink's tail. Set it before the job starts.
+    void setOutputSink(OutputSink *sink);
+    // Terminates the command's whole process group, the job then finishes as cancelled
+    void cancel();
+
+signals:
+    // The command's process is running, never emitted if it could not be launched
+    void started();
+    void outputReceived(const QString &chunk);
+    void finished(const CommandResult &result);
+
+private:
+    friend class CommandRunner;
+    friend class HostSpawnServer;
+    CommandJob(const QStringList &command, QProcess::ProcessChannelMode mode, int timeoutMs, QObject *parent);
+    // Runs the command in a process of its own
+    void startProcess(const QStringList &program);
+    // Runs the command through the host spawn server
+    void startRemote(HostSpawnServer *server);
+    void receiveOutput(QProcess::ProcessChannel channel, const QString &text);
+    void receiveExit(int exitCode, QProcess::ExitStatus exitStatus);
+    void storeOutput(QProcess::ProcessChannel channel, const QString &text);
+    void readStandardOutput();
+    void readStandardError();
+    void handleTimeout();
+    void terminateProcessGroup();
+    void finish();
+
+    QProcess *m_process = nullptr;
+    QPointer<HostSpawnServer> m_server;
+    QPointer<OutputSink> m_sink;
+    quint64 m_remoteId = 0;
+    QProcess::ProcessChannelMode m_channelMode;
+    QTimer *m_timeout = nullptr;
+    qint64 m_processGroup = 0;
+    QPromise<CommandResult> m_promise;
+    CommandResult m_result;
+    QStringDecoder m_stdoutDecoder{QStringDecoder::Utf8};
+    QStringDecoder m_stderrDecoder{QStringDecoder::Utf8};
+    bool m_finished = false;
+};
+
+// Asynchronous host command engine. Every command runs through a QProcess or
+// the host spawn server, both driven by the event loop, so nothing here ever
+// blocks the caller.
+class CommandRunner : public QObject
+{
+    Q_OBJECT
+public:
+    explicit CommandRunner(bool isFlatpak, QObject *parent = nullptr);
+
+    // Default timeout, in milliseconds, for commands that are expected to return quickly
+    static constexpr int DefaultTimeout = 60000;
+    // Time a cancelled process group gets to exit after SIGTERM before it is killed
+    static constexpr int KillGracePeriod = 5000;
+
+    bool isFlatpak() const;
+    QStringList hostCommand(const QStringList &command) const;
+
+    // Routes commands through the given spawn server instead of one flatpak-spawn each.
+    // Flatpak builds set one up by default, pass nullptr to spawn every command directly.
+    void setHostSpawnServer(HostSpawnServer *server);
+    HostSpawnServer *hostSpawnServer() const;
+
+    // Starts a command and returns the job driving it. A timeout of 0 disables it.
+    CommandJob *start(const QStringList &command,
+                      QProcess::ProcessChannelMode mode = QProcess::SeparateChannels,
+                      int timeoutMs = 0,
+                      const CancellationToken &token = CancellationToken());
+    QFuture<CommandResult> run(const QStringList &command,
+                               QProcess::ProcessChannelMode mode = QProcess::SeparateChannels,
+                               int timeoutMs = DefaultTimeout,
+                               const CancellationToken &token = CancellationToken());
+
+private:
+    bool m_isFlatpak;
+    HostSpawnServer *m_hostServer = nullptr;
+};
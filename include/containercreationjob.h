@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "cancellationtoken.h"
+#include "commandrunner.h"
+#include "outputsink.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+// Creates one container as a sequence of phases, each its own command. Every
+// step is driven from the event loop, so any number of creations can run side
+// by side without re-entering the caller.
+class ContainerCreationJob : public QObject
+{
+    Q_OBJECT
+public:
+    enum Phase {
+        Pull,
+        Create,
+        Init,
+        FirstEnter,
+    };
+    Q_ENUM(Phase)
+
+    struct Step {
+        Phase phase;
+        QStringList command;
+    };
+
+    ContainerCreationJob(CommandRunner *runner, const QString &name, const QList<Step> &steps, QObject *parent = nullptr);
+
+    static QString phaseName(Phase phase);
+
+    QString name() const;
+    Phase phase() const;
+    bool isRunning() const;
+    // Milliseconds the phase took, or -1 if it has not finished
+    qint64 phaseDuration(Phase phase) const;
+    OutputSink *output() const;
+
+    void start();
+    void cancel();
+    CancellationToken cancellationToken() const;
+
+signals:
+    void phaseStarted(ContainerCreationJob::Phase phase);
+    void phaseFinished(ContainerCreationJob::Phase phase, bool success, qint64 elapsedMs);
+    void outputReceived(const QString &chunk);
+    // Emitted once, the job deletes itself afterwards
+    void finished(bool success, bool cancelled, const QString &message);
+
+private:
+    void startStep(int index);
+    void finishStep(const CommandResult &result);
+    void complete(bool success, bool cancelled, const QString &message);
+
+    CommandRunner *m_runner;
+    QString m_name;
+    QList<Step> m_steps;
+    int m_current = -1;
+    QHash<Phase, qint64> m_durations;
+    QElapsedTimer m_phaseTimer;
+    CancellationToken m_token;
+    OutputSink *m_output;
+    bool m_running = false;
+};
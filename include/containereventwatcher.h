@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "cancellationtoken.h"
+#include "commandrunner.h"
+#include "containerinfo.h"
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+
+// Follows the container runtime's event stream for the containers of one
+// backend. The stream is restarted with a growing delay whenever it ends,
+// every restart is announced through resyncNeeded() because events may
+// have been missed in between.
+class ContainerEventWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ContainerEventWatcher(CommandRunner *runner, QObject *parent = nullptr);
+    ~ContainerEventWatcher() override;
+
+    // manager is podman or docker, backend selects the distrobox or toolbox label
+    void watch(const QString &manager, const QString &backend);
+    void stop();
+    // Whether the stream's process is running, events are then delivered as they happen
+    bool isActive() const;
+
+signals:
+    // action is create, start, stop, died or remove. Only id, name and image of container are set.
+    void containerEvent(const QString &action, const ContainerInfo &container);
+    void resyncNeeded();
+
+private:
+    void connectStream();
+    void handleOutput(const QString &chunk);
+    void handleLine(const QByteArray &line);
+    void handleStreamEnded();
+
+    CommandRunner *m_runner;
+    QString m_manager;
+    QString m_backend;
+    QPointer<CommandJob> m_job;
+    CancellationToken m_token;
+    QTimer *m_reconnectTimer;
+    QByteArray m_buffer;
+    int m_retryDelay = 0;
+    bool m_receivedEvent = false;
+    bool m_streaming = false;
+};
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include <QDataStream>
+#include <QList>
+#include <QMetaType>
+#include <QString>
+#include <QStringView>
+
+// Handle to a string stored once per process. Distro names and icon paths
+// repeat across every container and image, rows only keep this small id.
+class InternedString
+{
+public:
+    InternedString() = default;
+    explicit InternedString(const QString &string);
+
+    QString toString() const;
+    bool isEmpty() const
+    {
+        return m_id == 0;
+    }
+    quint32 id() const
+    {
+        return m_id;
+    }
+
+    bool operator==(InternedString other) const
+    {
+        return m_id == other.m_id;
+    }
+    bool operator!=(InternedString other) const
+    {
+        return m_id != other.m_id;
+    }
+
+private:
+    // 0 is the empty string
+    quint32 m_id = 0;
+};
+
+struct ContainerInfo {
+    enum class Status : quint8 {
+        Unknown,
+        Created,
+        Running,
+        Paused,
+        Exited,
+    };
+
+    QString id;
+    QString name;
+    QString image;
+    QString imageId;
+    // The runtime's own wording, e.g. "Up 2 hours"
+    QString statusText;
+    QString created;
+    InternedString distro;
+    InternedString icon;
+    // PRETTY_NAME from the container's os-release, empty until it was probed
+    QString osName;
+    // distrobox or toolbox
+    InternedString backend;
+    Status status = Status::Unknown;
+
+    // Maps runtime states (running, exited, stopped, ...) onto Status
+    static Status statusFromString(QStringView state);
+    static QString statusName(Status status);
+
+    // Identity used for diffing, the table fallbacks may not know the ID
+    QString key() const;
+
+    bool operator==(const ContainerInfo &other) const;
+    bool operator!=(const ContainerInfo &other) const
+    {
+        return !(*this == other);
+    }
+};
+Q_DECLARE_METATYPE(ContainerInfo)
+
+// Distro, icon and backend are written as strings, interned ids only mean something inside one process
+QDataStream &operator<<(QDataStream &stream, const ContainerInfo &container);
+QDataStream &operator>>(QDataStream &stream, ContainerInfo &container);
+
+struct ImageInfo {
+    QString url;
+    QString name;
+    QString version;
+    // Text shown in the image list, the URL unless something nicer is known
+    QString display;
+    InternedString distro;
+    InternedString icon;
+    // Already in the runtime's storage, creating from it needs no pull
+    bool local = false;
+};
+Q_DECLARE_METATYPE(ImageInfo)
+
+using ContainerList = QList<ContainerInfo>;
+using ImageList = QList<ImageInfo>;
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "containerinfo.h"
+#include "containerstatssampler.h"
+#include <QHash>
+#include <QAbstractListModel>
+#include <QString>
+
+// Containers of the current backend. Refreshes are diffed by container ID so
+// views only see the rows that were actually inserted, removed, moved or changed.
+class ContainerListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Roles {
+        ImageRole = Qt::UserRole + 3,
+        DistroRole,
+        IconRole,
+        ReadyRole,
+        PlaceholderRole,
+        IdRole,
+        StateRole,
+        StatusRole,
+        StaleRole,
+        // QList<ContainerStats>, oldest sample first
+        StatsRole,
+        // Only set while containers of several backends are shown
+        BackendRole,
+        // Bytes in the writable layer, -1 while unknown
+        SizeRole,
+        // Bytes of the image, shared with other containers of the same image, -1 while unknown
+        ImageSizeRole,
+        // The container's own PRETTY_NAME, e.g. "Fedora Linux 41 (Container Image)", empty while unknown
+        OsNameRole,
+    };
+
+    explicit ContainerListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    void setContainers(const ContainerList &containers);
+    ContainerInfo container(int row) const;
+    int rowOf(const QString &name) const;
+    // Resource usage history of the container with the given ID
+    void setStats(const QString &id, const QList<ContainerStats> &history);
+    void setSizes(const QString &id, qint64 size, qint64 imageSize);
+    // Whether rows name the backend they belong to
+    void setShowBackend(bool show);
+
+    // True from the start of a refresh until its result arrives
+    bool isLoading() const;
+    void setLoading(bool loading);
+    // Rows come from the startup snapshot and were not confirmed by the runtime yet
+    bool isStale() const;
+    void setStale(bool stale);
+
+signals:
+    void loadingChanged(bool loading);
+
+private:
+    ContainerList m_containers;
+    QHash<QString, QList<ContainerStats>> m_stats;
+    // Writable layer and image size per container ID
+    QHash<QString, std::pair<qint64, qint64>> m_sizes;
+    bool m_loading = false;
+    bool m_stale = false;
+    bool m_showBackend = false;
+};
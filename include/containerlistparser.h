@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "containerinfo.h"
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+// Turns container listings into ContainerInfo records. Distro and icon are
+// left to the caller.
+namespace ContainerListParser
+{
+// Runtime query that lists only the containers managed by the given backend
+QStringList runtimeListCommand(const QString &manager, const QString &backend);
+
+// podman ps --format json (one array) or docker ps --format json (one object per line).
+// ok is false if the output is not in either format.
+ContainerList parseRuntimeJson(const QString &output, bool *ok);
+
+// One object of podman events --format json or docker events --format '{{json .}}'.
+// Returns create, start, stop, died or remove, docker's spellings included, other
+// actions as the runtime names them and nothing for events that change nothing.
+// Only id, name and image of container are set.
+QString parseRuntimeEvent(const QJsonObject &event, ContainerInfo *container);
+
+// Fallbacks for runtimes without JSON output
+ContainerList parseDistroboxTable(const QString &output);
+ContainerList parseToolboxTable(const QString &output);
+}
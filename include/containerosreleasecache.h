@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "commandrunner.h"
+#include "containerinfo.h"
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+// The fields of an os-release file Kontainer cares about
+struct OsRelease {
+    QString id;
+    QString idLike;
+    QString versionId;
+    QString prettyName;
+
+    bool isValid() const
+    {
+        return !id.isEmpty();
+    }
+    static OsRelease parse(const QByteArray &contents);
+};
+
+// What a container says about itself in /etc/os-release. Running containers
+// are probed in one batch through /proc/<pid>/root, nothing is entered or
+// exec'd. Results are kept by container ID, also across restarts, so stopped
+// containers keep the distro they reported last.
+class ContainerOsReleaseCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ContainerOsReleaseCache(CommandRunner *runner, QObject *parent = nullptr);
+    ~ContainerOsReleaseCache() override;
+
+    // Probes the running containers of the list that were not probed since they started
+    void update(const ContainerList &containers, const QString &manager);
+
+    // Invalid until the container was probed
+    OsRelease osRelease(const QString &id) const;
+    // Name from the distro table, empty if the container is unknown or runs something the table lacks
+    QString distro(const QString &id) const;
+    // "deb", "rpm", "arch" or empty
+    QString packageFamily(const QString &id) const;
+
+signals:
+    void osReleaseChanged(const QStringList &ids);
+
+private:
+    void probe(const QStringList &ids, const QString &manager);
+    void load();
+    void save();
+
+    CommandRunner *m_runner;
+    QHash<QString, OsRelease> m_releases;
+    // Running containers probed since they started, successful or not
+    QSet<QString> m_probed;
+    QTimer *m_saveTimer;
+    static constexpr quint32 CACHE_MAGIC = 0x4b434f31; // "KCO1"
+    static constexpr quint16 CACHE_VERSION = 1;
+};
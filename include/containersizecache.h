@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "commandrunner.h"
+#include "containerinfo.h"
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+// Disk usage of containers, worked out lazily. The writable layer of each
+// container is measured on a worker thread, one container at a time, and
+// remembered together with the layer directory's mtime so unchanged
+// containers are not measured again, also across restarts. Image sizes are
+// shared by every container built from them and come from the runtime.
+class ContainerSizeCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ContainerSizeCache(CommandRunner *runner, QObject *parent = nullptr);
+    ~ContainerSizeCache() override;
+
+    // Measures whatever of the list is unknown or outdated, manager is used for the lookups
+    void update(const ContainerList &containers, const QString &manager);
+
+    // Bytes in the container's writable layer, -1 while unknown
+    qint64 containerSize(const QString &id) const;
+    // Bytes of the image the container was created from, -1 while unknown
+    qint64 imageSize(const QString &id) const;
+
+signals:
+    void sizesChanged(const QStringList &ids);
+
+private:
+    struct Entry {
+        QString upperDir;
+        QString imageId;
+        qint64 mtime = -1;
+        qint64 size = -1;
+        QDateTime measuredAt;
+    };
+
+    void inspect(const QStringList &ids, const QString &manager);
+    void inspectImages(const QStringList &imageIds, const QString &manager);
+    void queueMeasurement(const QString &id);
+    void measureNext();
+    void finishMeasurement(const QString &id, qint64 mtime, qint64 size);
+    bool isCurrent(const Entry &entry, bool running) const;
+    void load();
+    void save();
+
+    CommandRunner *m_runner;
+    QHash<QString, Entry> m_entries;
+    QHash<QString, qint64> m_imageSizes;
+    QSet<QString> m_running;
+    // Containers whose layer could not be found, not looked up again this session
+    QSet<QString> m_unavailable;
+    QSet<QString> m_inspecting;
+    QStringList m_queue;
+    bool m_measuring = false;
+    QTimer *m_saveTimer;
+    // A running container changes without touching its layer's top directory
+    static constexpr qint64 RUNNING_REMEASURE_SECS = 600;
+    static constexpr qint64 MAX_ENTRY_AGE_DAYS = 30;
+    static constexpr quint32 CACHE_MAGIC = 0x4b435a31; // "KCZ1"
+    static constexpr quint16 CACHE_VERSION = 1;
+};
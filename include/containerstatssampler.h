@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "commandrunner.h"
+#include "containerinfo.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMetaType>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+// One sample of a container's resource usage, rates are averaged over the sampling interval
+struct ContainerStats {
+    qint64 memoryBytes = 0;
+    // 100 is one fully used core
+    double cpuPercent = 0;
+    qint64 readBytesPerSecond = 0;
+    qint64 writeBytesPerSecond = 0;
+};
+Q_DECLARE_METATYPE(ContainerStats)
+
+// Samples running containers straight from their cgroup v2 files instead of
+// forking the runtime's stats command. The cgroup of each container is looked
+// up once when it starts running, every sample after that is a few reads in
+// /sys/fs/cgroup.
+class ContainerStatsSampler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ContainerStatsSampler(CommandRunner *runner, QObject *parent = nullptr);
+
+    // Samples kept per container for the sparklines
+    static constexpr int HISTORY_SIZE = 30;
+
+    // Milliseconds between samples, 0 turns sampling off
+    int interval() const;
+    void setInterval(int interval);
+
+    // While paused nothing is read, history is kept
+    bool isPaused() const;
+    void setPaused(bool paused);
+
+    // Follows the running containers of the list, manager is used to look up their cgroups
+    void setContainers(const ContainerList &containers, const QString &manager);
+
+    // Oldest sample first, empty for containers that are not sampled
+    QList<ContainerStats> history(const QString &id) const;
+
+signals:
+    // Containers that got a new sample
+    void statsUpdated(const QStringList &ids);
+
+private:
+    struct Counters {
+        qint64 cpuUsageUsec = -1;
+        qint64 readBytes = 0;
+        qint64 writeBytes = 0;
+    };
+
+    struct Sampled {
+        // Absolute cgroup directory, empty while it is being looked up
+        QString cgroup;
+        Counters counters;
+        QElapsedTimer sinceLast;
+        QList<ContainerStats> history;
+    };
+
+    void resolveCgroups(const QStringList &ids);
+    void updateTimer();
+    void sample();
+    bool readSample(Sampled &container, ContainerStats *stats);
+
+    CommandRunner *m_runner;
+    QTimer *m_timer;
+    QString m_manager;
+    QHash<QString, Sampled> m_containers;
+    // Containers whose cgroup could not be found, not retried until they stop
+    QSet<QString> m_unavailable;
+    int m_interval;
+    bool m_paused = false;
+};
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "containerinfo.h"
+#include "imagesearch.h"
 #include <KLocalizedString>
 #include <QApplication>
 #include <QCheckBox>
@@ -17,13 +19,14 @@
 #include <QListWidgetItem>
 #include <QMessageBox>
 #include <QPainter>
-#include <QProcess>
 #include <QProgressDialog>
 #include <QPushButton>
 #include <QStyle>
 #include <QStyledItemDelegate>
+#include <QTimer>
 #include <QToolButton>
 #include <QVBoxLayout>
+#include <memory>
 
 class Backend;
 class QLineEdit;
@@ -45,14 +48,15 @@ public:
     QStringList volumes() const;
 
 private slots:
-    void refreshImages();
-    void searchImages(const QString &query);
+    void reloadImages();
+    void searchImages();
     void startContainerCreation();
-    void handleCreateFinished(int exitCode, QProcess::ExitStatus exitStatus);
-    void handleReadyRead();
-    void handleErrorOccurred(QProcess::ProcessError error);
 
 private:
+    // Fills the list from the backend's images, listed again if reload is set
+    void showAvailableImages(bool reload);
+    void showImages(const QList<int> &rows);
+
     Backend *m_backend;
     QLineEdit *m_nameEdit;
     QLineEdit *m_searchEdit;
@@ -61,5 +65,12 @@ private:
     QLineEdit *m_volumesEdit;
     QCheckBox *m_initCheckbox;
     QProgressDialog *m_progressDialog;
-    QProcess *m_createProcess;
+    int m_imageRequest = 0;
+    // Built off the GUI thread once the catalog arrives, searches only read it
+    std::shared_ptr<const ImageSearchIndex> m_searchIndex;
+    QTimer *m_searchTimer;
+    int m_searchRequest = 0;
+    // Result of the last search, a longer query only rescans these rows
+    QString m_lastQuery;
+    QList<int> m_lastResult;
 };
@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include <QString>
+
+// Guesses the distro of an image from its reference. The patterns are
+// compiled once and recent answers are remembered, so classifying the same
+// image for every refresh costs a hash lookup.
+namespace DistroClassifier
+{
+// Safe to call from any thread, "unknown" if nothing matches
+QString classify(const QString &imageUrl);
+}
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include <QString>
+#include <QStringView>
+#include <string_view>
+
+// Everything Kontainer knows about distros, in one place. The tables are
+// constexpr; the lookup structures (a perfect hash for exact names, an
+// Aho-Corasick automaton for names inside image references) are generated
+// from them at compile time in distrotable.cpp.
+namespace DistroTable
+{
+// Listed in order of precedence, an image naming several families gets the first one
+enum class PackageFamily : quint8 {
+    None,
+    Arch,
+    Deb,
+    Rpm,
+};
+
+struct Distro {
+    std::string_view name;
+    // File below :/icons/, empty for names that only select a package family
+    std::string_view icon;
+    PackageFamily family;
+    // Whether the name is an answer of the image classifier
+    bool known;
+};
+
+struct ToolboxImage {
+    std::string_view distro;
+    std::string_view version;
+    std::string_view image;
+};
+
+// Sorted by name, lower case letters only. Substring lookups prefer the
+// alphabetically first name, which is what the earlier ordered lists did.
+inline constexpr Distro DISTROS[] = {
+    {"alma", "almalinux.svg", PackageFamily::None, true},
+    {"almalinux", "", PackageFamily::Rpm, false},
+    {"alpine", "alpine.svg", PackageFamily::None, true},
+    {"amazon", "amazonlinux.svg", PackageFamily::None, true},
+    {"amazonlinux", "amazonlinux.svg", PackageFamily::None, true},
+    {"arch", "archlinux.svg", PackageFamily::Arch, true},
+    {"bazzite", "bazzite.svg", PackageFamily::None, true},
+    {"blackarch", "blackarchlinux.svg", PackageFamily::Arch, true},
+    {"bluefin", "ublue.svg", PackageFamily::None, true},
+    {"bookworm", "debian.svg", PackageFamily::None, true},
+    {"bullseye", "debian.svg", PackageFamily::None, true},
+    {"buster", "debian.svg", PackageFamily::None, true},
+    {"centos", "centos.svg", PackageFamily::Rpm, true},
+    {"chainguard", "tux.svg", PackageFamily::None, true},
+    {"clearlinux", "clearlinux.svg", PackageFamily::None, true},
+    {"crystal", "crystal.svg", PackageFamily::Arch, true},
+    {"debian", "debian.svg", PackageFamily::Deb, true},
+    {"deepin", "deepin.svg", PackageFamily::None, true},
+    {"fedora", "fedora.svg", PackageFamily::Rpm, true},
+    {"gentoo", "gentoo.svg", PackageFamily::None, true},
+    {"kali", "kali-linux.svg", PackageFamily::Deb, true},
+    {"leap", "opensuse.svg", PackageFamily::None, true},
+    {"linuxmint", "linuxmint.svg", PackageFamily::Deb, true},
+    {"mageia", "mageia.svg", PackageFamily::Rpm, true},
+    {"mint", "", PackageFamily::Deb, false},
+    {"neon", "kde-neon.svg", PackageFamily::Deb, true},
+    {"neurodebian", "debian.svg", PackageFamily::Deb, true},
+    {"opensuse", "opensuse.svg", PackageFamily::Rpm, true},
+    {"oracle", "oracle.svg", PackageFamily::None, true},
+    {"plasma", "kde-neon.svg", PackageFamily::None, true},
+    {"popos", "", PackageFamily::Deb, false},
+    {"powershell", "tux.svg", PackageFamily::None, true},
+    {"redhat", "redhat.svg", PackageFamily::Rpm, true},
+    {"rhel", "redhat.svg", PackageFamily::Rpm, true},
+    {"rocky", "rocky-linux.svg", PackageFamily::None, true},
+    {"rockylinux", "", PackageFamily::Rpm, false},
+    {"slackware", "slackware.svg", PackageFamily::None, true},
+    {"steamos", "steamos.svg", PackageFamily::None, true},
+    {"suse", "", PackageFamily::Rpm, false},
+    {"toolbox", "tux.svg", PackageFamily::None, true},
+    {"tumbleweed", "tumbleweed.svg", PackageFamily::None, true},
+    {"ubi", "redhat.svg", PackageFamily::Rpm, true},
+    {"ublue", "ublue.svg", PackageFamily::None, true},
+    {"ubuntu", "ubuntu.svg", PackageFamily::Deb, true},
+    {"unknown", "tux.svg", PackageFamily::None, false},
+    {"vanilla", "vanilla.svg", PackageFamily::None, true},
+    {"void", "void.svg", PackageFamily::None, true},
+    {"vso", "vanilla.svg", PackageFamily::Deb, true},
+    {"wheezy", "", PackageFamily::None, true},
+    {"wolfi", "wolfi.svg", PackageFamily::None, true},
+};
+
+// Images offered when creating a toolbox, the distro must be listed above
+inline constexpr ToolboxImage TOOLBOX_IMAGES[] = {
+    {"alma", "8", "quay.io/toolbx-images/almalinux-toolbox:8"},
+    {"alma", "9", "quay.io/toolbx-images/almalinux-toolbox:9"},
+    {"alma", "10", "quay.io/toolbx-images/almalinux-toolbox:10"},
+    {"alma", "latest", "quay.io/toolbx-images/almalinux-toolbox:latest"},
+
+    {"alpine", "3.16", "quay.io/toolbx-images/alpine-toolbox:3.16"},
+    {"alpine", "3.17", "quay.io/toolbx-images/alpine-toolbox:3.17"},
+    {"alpine", "3.18", "quay.io/toolbx-images/alpine-toolbox:3.18"},
+    {"alpine", "3.19", "quay.io/toolbx-images/alpine-toolbox:3.19"},
+    {"alpine", "3.20", "quay.io/toolbx-images/alpine-toolbox:3.20"},
+    {"alpine", "edge", "quay.io/toolbx-images/alpine-toolbox:edge"},
+    {"alpine", "latest", "quay.io/toolbx-images/alpine-toolbox:latest"},
+
+    {"amazon", "2", "quay.io/toolbx-images/amazonlinux-toolbox:2"},
+    {"amazon", "2023", "quay.io/toolbx-images/amazonlinux-toolbox:2023"},
+    {"amazon", "latest", "quay.io/toolbx-images/amazonlinux-toolbox:latest"},
+
+    {"arch", "latest", "quay.io/toolbx/arch-toolbox:latest"},
+
+    {"bazzite", "latest-arch", "ghcr.io/ublue-os/bazzite-arch:latest"},
+    {"bazzite", "latest-arch-gnome", "ghcr.io/ublue-os/bazzite-arch-gnome:latest"},
+
+    {"centos", "stream8", "quay.io/toolbx-images/centos-toolbox:stream8"},
+    {"centos", "stream9", "quay.io/toolbx-images/centos-toolbox:stream9"},
+    {"centos", "stream10", "quay.io/toolbx-images/centos-toolbox:stream10"},
+    {"centos", "latest", "quay.io/toolbx-images/centos-toolbox:latest"},
+
+    {"debian", "10", "quay.io/toolbx-images/debian-toolbox:10"},
+    {"debian", "11", "quay.io/toolbx-images/debian-toolbox:11"},
+    {"debian", "12", "quay.io/toolbx-images/debian-toolbox:12"},
+    {"debian", "testing", "quay.io/toolbx-images/debian-toolbox:testing"},
+    {"debian", "unstable", "quay.io/toolbx-images/debian-toolbox:unstable"},
+    {"debian", "latest", "quay.io/toolbx-images/debian-toolbox:latest"},
+
+    {"fedora", "37", "registry.fedoraproject.org/fedora-toolbox:37"},
+    {"fedora", "38", "registry.fedoraproject.org/fedora-toolbox:38"},
+    {"fedora", "39", "registry.fedoraproject.org/fedora-toolbox:39"},
+    {"fedora", "40", "registry.fedoraproject.org/fedora-toolbox:40"},
+    {"fedora", "41", "quay.io/fedora/fedora-toolbox:41"},
+    {"fedora", "42", "quay.io/fedora/fedora-toolbox:42"},
+    {"fedora", "latest", "registry.fedoraproject.org/fedora-toolbox:latest"},
+    {"fedora", "rawhide", "quay.io/fedora/fedora-toolbox:rawhide"},
+
+    {"opensuse", "latest", "registry.opensuse.org/opensuse/distrobox:latest"},
+
+    {"redhat", "8", "registry.access.redhat.com/ubi8/toolbox"},
+    {"redhat", "9", "registry.access.redhat.com/ubi9/toolbox"},
+    {"redhat", "10", "registry.access.redhat.com/ubi10/toolbox"},
+
+    {"rocky", "8", "quay.io/toolbx-images/rockylinux-toolbox:8"},
+    {"rocky", "9", "quay.io/toolbx-images/rockylinux-toolbox:9"},
+    {"rocky", "latest", "quay.io/toolbx-images/rockylinux-toolbox:latest"},
+
+    {"ubuntu", "16.04", "quay.io/toolbx/ubuntu-toolbox:16.04"},
+    {"ubuntu", "18.04", "quay.io/toolbx/ubuntu-toolbox:18.04"},
+    {"ubuntu", "20.04", "quay.io/toolbx/ubuntu-toolbox:20.04"},
+    {"ubuntu", "22.04", "quay.io/toolbx/ubuntu-toolbox:22.04"},
+    {"ubuntu", "24.04", "quay.io/toolbx/ubuntu-toolbox:24.04"},
+    {"ubuntu", "latest", "quay.io/toolbx/ubuntu-toolbox:latest"},
+
+    {"wolfi", "latest", "quay.io/toolbx-images/wolfi-toolbox:latest"},
+};
+
+inline QString toQString(std::string_view string)
+{
+    return QString::fromLatin1(string.data(), static_cast<qsizetype>(string.size()));
+}
+
+// Exact, case-insensitive lookup, nullptr for names not in the table
+const Distro *find(QStringView name);
+
+// Alphabetically first classifier answer contained in text, empty if there is none
+QString knownDistroIn(QStringView text);
+
+// Resource path of the distro's icon, tux for anything unknown
+QString iconPath(QStringView distro);
+
+// Package family of the distro an image reference names
+PackageFamily packageFamily(QStringView image);
+// "deb", "rpm", "arch" or empty
+QString packageFamilyName(PackageFamily family);
+
+// nullptr for images that are not one of TOOLBOX_IMAGES
+const ToolboxImage *findToolboxImage(QStringView image);
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QProcess>
+#include <QSet>
+#include <QStringList>
+#include <utility>
+
+class CommandJob;
+
+// Long-lived helper on the host that runs commands on our behalf. Instead of
+// paying a flatpak-spawn round-trip for every command, requests and their
+// stdout/stderr are multiplexed over the helper's stdin/stdout.
+class HostSpawnServer : public QObject
+{
+    Q_OBJECT
+public:
+    // launcher is the prefix used to start the helper on the host, e.g. flatpak-spawn --host
+    explicit HostSpawnServer(const QStringList &launcher, QObject *parent = nullptr);
+    ~HostSpawnServer() override;
+
+    static QStringList flatpakLauncher();
+    // Whether a command can be expressed in the line based request protocol
+    static bool canTransport(const QStringList &command);
+
+    // False once the helper failed to launch, callers should spawn directly then
+    bool isAvailable() const;
+    // Returns the request id, or 0 if the job had to be started as a process of its own
+    quint64 submit(CommandJob *job);
+    void forget(quint64 id);
+    // Kills the request's process group on the host and drops its remaining output
+    void cancel(quint64 id);
+
+private:
+    bool ensureStarted();
+    void readOutput();
+    void handleLine(const QByteArray &line);
+    void handleHelperExit();
+    void handleHelperError(QProcess::ProcessError error);
+    void fallBackToDirectSpawn();
+
+    QStringList m_launcher;
+    QProcess *m_process = nullptr;
+    QByteArray m_buffer;
+    QHash<quint64, QPointer<CommandJob>> m_jobs;
+    // Host process group of each running request, as reported by the helper
+    QHash<quint64, qint64> m_processGroups;
+    // Cancelled requests whose process group is not known yet
+    QSet<quint64> m_pendingKills;
+    // Leading pieces of long lines, per request and channel (O or E), until the last piece arrives
+    QHash<std::pair<quint64, char>, QByteArray> m_partialLines;
+    quint64 m_nextId = 1;
+    bool m_failed = false;
+    bool m_helperResponded = false;
+    bool m_dispatching = false;
+};
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "commandrunner.h"
+#include "containerinfo.h"
+#include <QDateTime>
+#include <QFuture>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+// The images distrobox offers (distrobox create -C). Listed once per
+// session, kept in memory and on disk; the disk copy is used for a day as
+// long as the installed distrobox version is the one that produced it.
+class ImageCatalog : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ImageCatalog(CommandRunner *runner, QObject *parent = nullptr);
+
+    // Ready at once after the first load, concurrent callers share one load
+    QFuture<ImageList> images();
+    // Lists the images again, ignoring and then rewriting the disk copy. The
+    // previous list stays in use if that fails.
+    QFuture<ImageList> reload();
+
+    // Classified catalog entries for image references
+    static ImageList toImages(const QStringList &urls);
+
+private:
+    QFuture<ImageList> start(bool useCache);
+    QFuture<ImageList> load(bool useCache);
+    QFuture<ImageList> fetch(const QString &distroboxVersion);
+    bool loadCache(const QString &distroboxVersion, QStringList *urls) const;
+    void saveCache(const QString &distroboxVersion, const QStringList &urls) const;
+
+    CommandRunner *m_runner;
+    ImageList m_images;
+    bool m_loaded = false;
+    QFuture<ImageList> m_pending;
+    bool m_loading = false;
+    // Bumped by every load, only the latest one may store its result
+    int m_generation = 0;
+    static constexpr qint64 CACHE_TTL_SECS = 24 * 60 * 60;
+    static constexpr quint32 CACHE_MAGIC = 0x4b434931; // "KCI1"
+    static constexpr quint16 CACHE_VERSION = 1;
+};
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "containerinfo.h"
+#include <QHash>
+#include <QList>
+#include <QString>
+
+// Filtering of the image catalog for the create dialog's search field
+namespace ImageSearch
+{
+// Images whose name, distro or URL contain query, case-insensitively, in catalog order
+ImageList filter(const ImageList &images, const QString &query);
+}
+
+// Trigram index over an image catalog. Matches are substrings of the
+// image's registry, name, distro or version, ranked: exact distro first,
+// then name prefixes, then word prefixes, then anything else, each with
+// local images ahead and newest tag first. Immutable once built, so
+// searches may run on any thread.
+class ImageSearchIndex
+{
+public:
+    ImageSearchIndex() = default;
+    explicit ImageSearchIndex(const ImageList &images);
+
+    qsizetype size() const
+    {
+        return m_images.size();
+    }
+    const ImageInfo &image(int row) const
+    {
+        return m_images.at(row);
+    }
+
+    // Rows matching query, best first. When query extends an earlier query,
+    // passing that query's result only rescans those rows.
+    QList<int> search(const QString &query, const QList<int> *previous = nullptr) const;
+
+private:
+    struct Entry {
+        // "registry/path/name:tag\ndistro\nversion" in lower case
+        QString text;
+        QString distro;
+        // Offset of the name (last path segment) in text
+        qsizetype nameStart = 0;
+        // Higher is newer, "latest" and friends above every version
+        qint64 tagRank = 0;
+        bool local = false;
+    };
+
+    int score(const Entry &entry, const QString &query, qsizetype position) const;
+    QList<int> candidates(const QString &query) const;
+
+    ImageList m_images;
+    QList<Entry> m_entries;
+    // Three UTF-16 code units packed into one key, rows in ascending order
+    QHash<quint64, QList<int>> m_trigrams;
+};
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "jobscheduler.h"
+#include "logview.h"
+#include <QDialog>
+#include <QHash>
+#include <QLabel>
+#include <QPushButton>
+#include <QTabWidget>
+
+// Follows several jobs at once, with one output tab and exit status per job
+class JobProgressDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    JobProgressDialog(JobScheduler *scheduler, const QList<quint64> &jobIds, QWidget *parent = nullptr);
+
+private:
+    struct JobTab {
+        int index = -1;
+        LogView *output = nullptr;
+    };
+
+    void updateJob(const JobInfo &job);
+    void appendOutput(quint64 id, const QString &chunk);
+    void finishJob(const JobInfo &job, const CommandResult &result);
+    void updateSummary();
+
+    JobScheduler *m_scheduler;
+    QTabWidget *m_tabs;
+    QLabel *m_summaryLabel;
+    QPushButton *m_cancelBtn;
+    QPushButton *m_closeBtn;
+    QHash<quint64, JobTab> m_jobTabs;
+    int m_finished = 0;
+    int m_failed = 0;
+};
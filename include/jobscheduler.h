@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "commandrunner.h"
+#include "outputsink.h"
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+struct JobInfo {
+    enum State {
+        Queued,
+        Running,
+        Finished,
+        Failed,
+        Cancelled,
+    };
+
+    quint64 id = 0;
+    QString container;
+    // Jobs sharing a non-empty group never run at the same time either
+    QString group;
+    QString title;
+    QStringList command;
+    State state = Queued;
+    int exitCode = -1;
+    QDateTime queuedAt;
+    QDateTime startedAt;
+    QDateTime finishedAt;
+};
+Q_DECLARE_METATYPE(JobInfo)
+
+// Runs long operations with one serialized queue per container. Jobs for
+// different containers run in parallel up to a global concurrency cap, jobs
+// for the same container (or the same group) run in the order they were queued.
+class JobScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit JobScheduler(CommandRunner *runner, QObject *parent = nullptr);
+
+    // Queue key for operations that touch every container at once
+    static inline const QString AllContainers = QStringLiteral("*");
+
+    int maxConcurrent() const;
+    void setMaxConcurrent(int maxConcurrent);
+
+    quint64 enqueue(const QString &container, const QString &title, const QStringList &command, const QString &group = QString());
+
+    // Drops a queued job or terminates a running one, it then finishes as Cancelled
+    void cancel(quint64 id);
+
+    JobInfo job(quint64 id) const;
+    // Queued and running jobs followed by the most recently finished ones
+    QList<JobInfo> jobs() const;
+    // Full output of a job still in the history, nullptr otherwise
+    OutputSink *output(quint64 id) const;
+    int runningCount() const;
+    int queuedCount() const;
+
+signals:
+    void jobChanged(const JobInfo &job);
+    void jobOutput(quint64 id, const QString &chunk);
+    void jobFinished(const JobInfo &job, const CommandResult &result);
+
+private:
+    void schedule();
+    quint64 nextStartable() const;
+    void startJob(quint64 id);
+    void retire(quint64 id);
+
+    CommandRunner *m_runner;
+    int m_maxConcurrent;
+    quint64 m_nextId = 1;
+    QHash<quint64, JobInfo> m_jobs;
+    // Queued job ids in submission order
+    QList<quint64> m_pending;
+    QList<quint64> m_finished;
+    QHash<quint64, OutputSink *> m_outputs;
+    QHash<quint64, CancellationToken> m_tokens;
+    QSet<QString> m_busyContainers;
+    QSet<QString> m_busyGroups;
+    int m_running = 0;
+    static constexpr int FINISHED_HISTORY = 50;
+};
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "jobscheduler.h"
+#include <QDialog>
+#include <QHash>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTimer>
+#include <QTreeWidget>
+
+// Lists queued, running and recently finished background jobs
+class JobsDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit JobsDialog(JobScheduler *scheduler, QWidget *parent = nullptr);
+
+private:
+    void updateJob(const JobInfo &job);
+    void removeExpiredJobs();
+    void updateDurations();
+    void updateSummary();
+    void showLog();
+    void updateButtons();
+    quint64 selectedJob() const;
+
+    JobScheduler *m_scheduler;
+    QTreeWidget *m_jobsTree;
+    QLabel *m_summaryLabel;
+    QSpinBox *m_concurrencySpin;
+    QPushButton *m_showLogBtn;
+    QPushButton *m_cancelJobBtn;
+    QTimer *m_durationTimer;
+    QHash<quint64, QTreeWidgetItem *> m_items;
+};
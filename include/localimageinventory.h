@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include "commandrunner.h"
+#include "containerinfo.h"
+#include <QFuture>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+// Images already in the runtime's local storage, listed once as JSON and
+// kept in memory until something may have pulled a new one. Creating a
+// container from one of them needs no registry round-trip.
+class LocalImageInventory : public QObject
+{
+    Q_OBJECT
+public:
+    struct LocalImage {
+        // Tagged references, "registry/path/name:tag"
+        QStringList names;
+        // Pinned references, "registry/path/name@sha256:..."
+        QStringList digests;
+    };
+
+    explicit LocalImageInventory(CommandRunner *runner, QObject *parent = nullptr);
+
+    // Local images of manager, flagged local. Ready at once while the listing is current,
+    // concurrent callers share one listing.
+    QFuture<ImageList> images(const QString &manager);
+    // Whether manager's storage holds exactly this tag or digest, as of the last listing
+    bool contains(const QString &manager, const QString &reference) const;
+    // The next images() lists the storage again
+    void invalidate();
+
+    // Catalog images found locally flagged and moved to the front, followed by
+    // local images the catalog does not offer, then the rest of the catalog
+    static ImageList merge(const ImageList &catalog, const ImageList &local);
+    // podman images --format json (one array) or docker images --format json (one object per line)
+    static QList<LocalImage> parse(const QString &output);
+    // Fully qualified the way the runtimes store it: "alpine" is "docker.io/library/alpine:latest"
+    static QString normalizeReference(QStringView reference);
+
+private:
+    void store(const QString &manager, const QList<LocalImage> &images);
+
+    CommandRunner *m_runner;
+    QString m_manager;
+    ImageList m_images;
+    // Normalized names and digests of everything in m_images' storage
+    QSet<QString> m_references;
+    bool m_loaded = false;
+    QFuture<ImageList> m_pending;
+    QString m_pendingManager;
+    bool m_loading = false;
+    // Bumped by invalidate(), a listing started before it is not current
+    int m_generation = 0;
+};
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include <QPlainTextEdit>
+#include <QString>
+#include <QTimer>
+
+// Read-only view for streamed command output. Chunks are coalesced and
+// rendered at most once per frame, carriage-return progress lines are
+// redrawn in place and only the last maximumBlockCount() lines are kept.
+class LogView : public QPlainTextEdit
+{
+    Q_OBJECT
+public:
+    explicit LogView(QWidget *parent = nullptr);
+
+    void appendOutput(const QString &chunk);
+    // Renders anything still waiting for the next frame
+    void flush();
+
+private:
+    void clearCurrentLine(QTextCursor &cursor);
+
+    QString m_pending;
+    QTimer *m_flushTimer;
+    // The last line ended in \r, the next text overwrites it
+    bool m_carriageReturn = false;
+};
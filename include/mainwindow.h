@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "containerinfo.h"
 #include <QApplication>
 #include <QComboBox>
 #include <QDir>
@@ -11,25 +12,33 @@
 #include <QHBoxLayout>
 #include <QIcon>
 #include <QLabel>
-#include <QListWidget>
+#include <QListView>
+#include <QLocale>
+#include <QPixmapCache>
 #include <QMainWindow>
 #include <QMessageBox>
 #include <QPainter>
+#include <QPointer>
+#include <QPolygonF>
 #include <QProgressBar>
 #include <QProgressDialog>
 #include <QPushButton>
 #include <QSettings>
+#include <QSortFilterProxyModel>
+#include <QStatusBar>
 #include <QStyle>
 #include <QStyledItemDelegate>
 #include <QTabWidget>
-#include <QTextEdit>
 #include <QToolBar>
 #include <QToolButton>
 #include <QVBoxLayout>
 #include <cctype>
 
 class Backend;
-class QListWidget;
+class LogView;
+class QListView;
+class ContainerListModel;
+class QSortFilterProxyModel;
 class QPushButton;
 class CreateContainerDialog;
 
@@ -42,6 +51,11 @@ public:
     void showCommandOutput(const QString &output);
     QString preferredBackend;
 
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+    void changeEvent(QEvent *event) override;
+
 private slots:
     void refreshContainers();
     void enterContainer();
@@ -54,12 +68,17 @@ private slots:
     void installDebPackage();
     void installRpmPackage();
     void installArchPackage();
+    void showJobsDialog();
     void onBackendsAvailable(const QStringList &backends);
-    void handleContainersFetched(const QList<QMap<QString, QString>> &containers);
+    void handleContainersFetched(const ContainerList &containers);
 
 private:
     void setupUI();
     void setupLoadingUI();
+    void updateBackendSelector();
+    void applyContainerSorting(bool bySize);
+    // Resource sampling only runs while the window can be seen
+    void updateStatsSampling();
     void setupContainerList();
     void setupActionButtons();
     void showAppsForContainer(const QString &name);
@@ -71,14 +90,19 @@ private:
     QPushButton *installArchBtn;
     QString getContainerDistro() const;
     bool hasTerminal = false;
-    QTextEdit *progressOutput;
+    QPointer<LogView> progressOutput;
     void setupProgressDialog(const QString &title);
     void appendCommandOutput(const QString &output);
     QProgressDialog *loadingDialog = nullptr;
     void cleanupProgressDialog();
+    void followJob(quint64 jobId, const QString &title);
+    void updateJobsStatus();
 
     Backend *backend;
-    QListWidget *containerList;
+    QListView *containerList;
+    ContainerListModel *containerModel = nullptr;
+    QSortFilterProxyModel *containerProxy = nullptr;
+    QComboBox *backendSelector = nullptr;
     QPushButton *enterBtn;
     QPushButton *deleteBtn;
     QPushButton *appsBtn;
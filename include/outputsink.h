@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QTemporaryFile>
+
+// Bounded store for the output of a long-running command. Only the last
+// capacity() characters are kept in memory, once that is exceeded the whole
+// log is spilled to a temporary file that is removed with the sink.
+class OutputSink : public QObject
+{
+    Q_OBJECT
+public:
+    explicit OutputSink(QObject *parent = nullptr);
+    OutputSink(qsizetype capacity, QObject *parent);
+
+    // Configured through jobs/outputBufferSize, in characters
+    static qsizetype defaultCapacity();
+
+    qsizetype capacity() const;
+    // Endless streams only need their tail, keep them off the disk
+    void setSpillToDisk(bool spill);
+    void append(const QString &chunk);
+
+    // The most recent output, at most capacity() characters
+    QString tail() const;
+    // Total characters written, including what only lives in the log file
+    qsizetype size() const;
+    bool isTruncated() const;
+    // Empty as long as everything still fits in memory
+    QString logFilePath() const;
+    // Reads back the complete log, from disk if it was spilled
+    QString readAll() const;
+
+private:
+    void spill();
+
+    qsizetype m_capacity;
+    qsizetype m_size = 0;
+    QString m_buffer;
+    // Start of the tail inside m_buffer, the buffer is compacted lazily
+    qsizetype m_start = 0;
+    QTemporaryFile *m_logFile = nullptr;
+    bool m_spillToDisk = true;
+    bool m_spillFailed = false;
+};
@@ -4,34 +4,15 @@
 // include/packagemanager.h
 #pragma once
 
+#include "distrotable.h"
 #include <QString>
-#include <QStringList>
 
 class PackageManager
 {
 public:
+    // Package format of the image's distro, "deb", "rpm", "arch" or empty
     static QString getDistroFromImage(const QString &image)
     {
-        QString lowerImage = image.toLower();
-
-        // Define package type mappings
-        static const QMap<QString, QStringList> distroMappings = {
-            {"deb", {"debian", "ubuntu", "mint", "vso", "popos", "kali", "neon", "nd\\d+"}},
-            {"rpm", {"fedora", "rhel", "centos", "opensuse", "suse", "rockylinux", "ubi\\d*", "redhat", "ubi", "almalinux", "mageia"}},
-            {"arch", {"arch", "blackarch", "archlinux", "arch-toolbox", "arch-distrobox", "crystal"}}};
-
-        // Check each package type
-        for (auto it = distroMappings.constBegin(); it != distroMappings.constEnd(); ++it) {
-            const QString &pkgType = it.key();
-            const QStringList &distros = it.value();
-
-            for (const QString &distro : distros) {
-                if (lowerImage.contains(distro)) {
-                    return pkgType;
-                }
-            }
-        }
-
-        return "";
+        return DistroTable::packageFamilyName(DistroTable::packageFamily(image));
     }
 };
@@ -0,0 +1,65 @@
+# SPDX-FileCopyrightText: none
+# SPDX-License-Identifier: CC0-1.0
+#
+# Host side of Kontainer's spawn server. Started once through flatpak-spawn,
+# it reads one request per line from stdin and runs the commands concurrently,
+# multiplexing their output back over stdout:
+#
+#   requests: R <id> <shell-quoted arguments...>
+#             K <process group>
+#   replies:  <id> P <process group>
+#             <id> O <stdout line>
+#             <id> E <stderr line>
+#             <id> o|e <first pieces of a long stdout|stderr line>
+#             <id> X <exit code>
+
+exec 4>&1
+
+# Every job writes to the shared stdout, only writes up to PIPE_BUF (4096 on
+# Linux) are kept whole. Longer lines go out in pieces tagged o or e, the
+# last piece carries the usual O or E. One flush per line, one write each.
+tag() {
+    LC_ALL=C awk -v id="$1" -v type="$2" '{
+        line = $0
+        while (length(line) > 3072) {
+            printf "%s %s %s\n", id, tolower(type), substr(line, 1, 3072)
+            fflush()
+            line = substr(line, 3073)
+        }
+        printf "%s %s %s\n", id, type, line
+        fflush()
+    }'
+}
+
+# Runs the command as the leader of a new process group and reports that group over fd 6
+spawn() {
+    id=$1
+    shift
+    if command -v setsid >/dev/null 2>&1; then
+        setsid -w sh -c 'printf "%s P %s\n" "$1" "$$" >&6; shift; exec "$@" 6>&-' sh "$id" "$@"
+    else
+        "$@" 6>&-
+    fi
+}
+
+run() {
+    id=$1
+    shift
+    # The exit code travels over fd 5 so X is only sent once both streams are drained
+    rc=$({ { { spawn "$id" "$@" </dev/null 2>&1 1>&3 6>&4 3>&- 4>&- 5>&-; echo $? >&5; } | tag "$id" E >&4 5>&-; } 3>&1 | tag "$id" O >&4 5>&-; } 5>&1)
+    printf '%s X %s\n' "$id" "${rc:-127}"
+}
+
+while IFS= read -r request; do
+    case $request in
+    "R "*)
+        eval "run ${request#R }" &
+        ;;
+    "K "[0-9]*)
+        group=${request#K }
+        { kill -TERM -"$group" 2>/dev/null; sleep 5; kill -KILL -"$group" 2>/dev/null; } &
+        ;;
+    esac
+done
+
+wait
@@ -89,9 +89,12 @@ AppsDialog::AppsDialog(Backend *backend, const QString &containerName, QWidget *
     connect(m_unexportBtn, &QPushButton::clicked, [this]() {
         if (m_exportedAppsList->currentItem()) {
             QString app = m_exportedAppsList->currentItem()->text();
-            QString result = m_backend->unexportApp(app, m_containerName);
-            QMessageBox::information(this, i18n("Unexport App"), result);
-            loadApps();
+            m_unexportBtn->setEnabled(false);
+            m_backend->unexportApp(app, m_containerName).then(this, [this](const QString &result) {
+                m_unexportBtn->setEnabled(true);
+                QMessageBox::information(this, i18n("Unexport App"), result);
+                loadApps();
+            });
         }
     });
 
@@ -124,9 +127,12 @@ AppsDialog::AppsDialog(Backend *backend, const QString &containerName, QWidget *
     connect(m_exportBtn, &QPushButton::clicked, [this]() {
         if (m_availableAppsList->currentItem()) {
             QString app = m_availableAppsList->currentItem()->text();
-            QString result = m_backend->exportApp(app, m_containerName);
-            QMessageBox::information(this, i18n("Export App"), result);
-            loadApps();
+            m_exportBtn->setEnabled(false);
+            m_backend->exportApp(app, m_containerName).then(this, [this](const QString &result) {
+                m_exportBtn->setEnabled(true);
+                QMessageBox::information(this, i18n("Export App"), result);
+                loadApps();
+            });
         }
     });
 
@@ -161,26 +167,35 @@ void AppsDialog::loadApps()
         m_exportedAppsList->addItem(item);
     }
 
-    m_availableAppsList->clear();
-    QStringList availableApps = m_backend->getAvailableApps(m_containerName);
-    for (const QString &app : availableApps) {
-        QIcon icon = QIcon::fromTheme(app.toLower());
-        if (icon.isNull()) {
-            icon = QIcon::fromTheme("package-x-generic");
-        }
-        QListWidgetItem *item = new QListWidgetItem(icon, app);
-        m_availableAppsList->addItem(item);
-    }
-
     m_exportedAppsList->setVisible(!exportedApps.isEmpty());
     m_noExportedLabel->setVisible(exportedApps.isEmpty());
     m_unexportBtn->setVisible(!exportedApps.isEmpty());
 
-    m_availableAppsList->setVisible(!availableApps.isEmpty());
-    m_noAvailableLabel->setVisible(availableApps.isEmpty());
-    m_exportBtn->setVisible(!availableApps.isEmpty());
-
     if (exportedApps.isEmpty() && m_tabs->currentIndex() == 0) {
         m_tabs->setCurrentIndex(1);
     }
+
+    // Listing the apps inside the container takes a while, fill that tab in once it is done
+    m_availableAppsList->clear();
+    m_availableAppsList->setVisible(false);
+    m_exportBtn->setVisible(false);
+    m_noAvailableLabel->setText(i18n("Loading applications..."));
+    m_noAvailableLabel->setVisible(true);
+
+    m_backend->getAvailableApps(m_containerName).then(this, [this](const QStringList &availableApps) {
+        m_availableAppsList->clear();
+        for (const QString &app : availableApps) {
+            QIcon icon = QIcon::fromTheme(app.toLower());
+            if (icon.isNull()) {
+                icon = QIcon::fromTheme("package-x-generic");
+            }
+            QListWidgetItem *item = new QListWidgetItem(icon, app);
+            m_availableAppsList->addItem(item);
+        }
+
+        m_noAvailableLabel->setText(i18n("No available applications"));
+        m_availableAppsList->setVisible(!availableApps.isEmpty());
+        m_noAvailableLabel->setVisible(availableApps.isEmpty());
+        m_exportBtn->setVisible(!availableApps.isEmpty());
+    });
 }
@@ -3,88 +3,263 @@
 
 #include "backend.h"
 #include "appflags.h"
+#include "containerlistparser.h"
+#include "distroclassifier.h"
+#include "distrotable.h"
 #include "packagemanager.h"
+#include <QDataStream>
+#include <QSaveFile>
 #include <mainwindow.h>
-#include <toolboximages.h>
+#include <memory>
 
 Backend::Backend(QObject *parent)
     : QObject(parent)
 {
     m_isFlatpak = QFile::exists("/.flatpak-info");
+    m_runner = new CommandRunner(m_isFlatpak, this);
+    m_jobScheduler = new JobScheduler(m_runner, this);
+    m_statsSampler = new ContainerStatsSampler(m_runner, this);
+    m_sizeCache = new ContainerSizeCache(m_runner, this);
+    m_osReleases = new ContainerOsReleaseCache(m_runner, this);
+    m_imageCatalog = new ImageCatalog(m_runner, this);
+    m_localImages = new LocalImageInventory(m_runner, this);
+    connect(m_osReleases, &ContainerOsReleaseCache::osReleaseChanged, this, &Backend::applyOsReleases);
+
+    connect(m_jobScheduler, &JobScheduler::jobOutput, this, [this](quint64, const QString &chunk) {
+        emit outputReceived(chunk);
+    });
+    connect(m_jobScheduler, &JobScheduler::jobFinished, this, [this](const JobInfo &job, const CommandResult &result) {
+        const auto onFinished = m_jobCallbacks.take(job.id);
+        if (!onFinished)
+            return;
+
+        QString output = result.standardOutput;
+        if (result.outputTruncated) {
+            output.prepend(i18n("[Output truncated, the full log is available in the jobs dialog]\n"));
+        }
+        if (result.cancelled) {
+            output += i18n("\nCancelled");
+        } else if (!result.success()) {
+            output += i18n("\nError: Command failed with exit code %1", result.exitCode);
+        }
+        onFinished(output, result);
+    });
 
     QSettings settings;
     m_preferredBackend = settings.value("container/backend", "distrobox").toString();
+    m_listAllBackends = settings.value("container/listAllBackends", false).toBool();
+
+    qRegisterMetaType<ContainerInfo>();
+    qRegisterMetaType<ImageInfo>();
+    qRegisterMetaType<ContainerList>();
+    qRegisterMetaType<ImageList>();
+
+    // Writing the snapshot is deferred so a burst of updates only hits the disk once
+    m_snapshotTimer = new QTimer(this);
+    m_snapshotTimer->setSingleShot(true);
+    m_snapshotTimer->setInterval(1000);
+    connect(m_snapshotTimer, &QTimer::timeout, this, &Backend::saveContainerSnapshot);
+
+    connect(this, &Backend::containersFetched, this, [this](const ContainerList &containers) {
+        m_snapshotTimer->start();
+        m_statsSampler->setContainers(containers, containerManager());
+        m_sizeCache->update(containers, containerManager());
+        m_osReleases->update(containers, containerManager());
+    });
 
-    connect(this, &Backend::containersFetched, this, [this](const QList<QMap<QString, QString>> &containers) {
-        m_currentContainers = containers;
+    // Bursts of events (e.g. assemble creating several containers) end up in one update
+    m_eventFlushTimer = new QTimer(this);
+    m_eventFlushTimer->setSingleShot(true);
+    m_eventFlushTimer->setInterval(50);
+    connect(m_eventFlushTimer, &QTimer::timeout, this, [this]() {
+        emit containersFetched(visibleContainers());
     });
 
     checkAvailableBackends();
 
+    // The terminal KTerminalLauncherJob picks lives in kdeglobals, re-probe only when it changes
+    m_terminalConfigWatcher = new QFileSystemWatcher(this);
+    connect(m_terminalConfigWatcher, &QFileSystemWatcher::fileChanged, this, &Backend::handleTerminalConfigChanged);
+    connect(m_terminalConfigWatcher, &QFileSystemWatcher::directoryChanged, this, &Backend::handleTerminalConfigChanged);
+    watchTerminalConfig();
+
     checkTerminaljob();
 }
 
-// Getter and technically setter
-bool Backend::isTerminalJobPossible() {
-    checkTerminaljob();
+Backend::~Backend()
+{
+    if (m_snapshotTimer->isActive())
+        saveContainerSnapshot();
+}
+
+bool Backend::isTerminalJobPossible()
+{
+    if (m_terminalProbeNoTerminal != g_noTerminal) {
+        checkTerminaljob();
+    }
     return m_isTerminalJobPossible;
 }
 
 void Backend::checkTerminaljob()
 {
+    const bool wasPossible = m_isTerminalJobPossible;
+    m_terminalProbeNoTerminal = g_noTerminal;
+    m_terminalConfiguration = currentTerminalConfiguration();
+
     if (g_noTerminal) {
         qDebug() << "Terminal job check skipped due to --no-terminal flag";
         m_isTerminalJobPossible = false;
-        return;
+    } else {
+        KTerminalLauncherJob job(QStringLiteral("true"));
+        m_isTerminalJobPossible = job.prepare();
     }
 
-    KTerminalLauncherJob job(QStringLiteral("true"));
-    m_isTerminalJobPossible = job.prepare();
+    if (m_isTerminalJobPossible != wasPossible) {
+        Q_EMIT terminalAvailabilityChanged(m_isTerminalJobPossible);
+    }
 }
 
-void Backend::checkAvailableBackends()
+QString Backend::currentTerminalConfiguration() const
 {
-    auto isAvailable = [this](const QString &name) -> QFuture<bool> {
-        return QtConcurrent::run([this, name]() -> bool {
-            if (m_isFlatpak) {
-                QProcess whichProcess;
-                whichProcess.start("flatpak-spawn", {"--host", "which", name});
-                if (!whichProcess.waitForStarted()) {
-                    return false;
-                }
-                QEventLoop loop;
-                QObject::connect(&whichProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), &loop, &QEventLoop::quit);
-                loop.exec();
-                return (whichProcess.exitCode() == 0);
-            } else {
-                return !QStandardPaths::findExecutable(name).isEmpty();
-            }
-        });
-    };
+    KConfigGroup general(KSharedConfig::openConfig(), QStringLiteral("General"));
+    return general.readEntry("TerminalApplication") + QLatin1Char('\n') + general.readEntry("TerminalService");
+}
 
-    const QList<QString> backends = {"distrobox", "toolbox"};
-    QList<QFuture<bool>> futures;
+void Backend::watchTerminalConfig()
+{
+    const QString configDir = QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation);
+    const QString kdeglobals = configDir + QStringLiteral("/kdeglobals");
 
-    for (const auto &backend : backends) {
-        futures.append(isAvailable(backend));
+    // KConfig replaces the file on save, which drops it from the watcher
+    if (QFile::exists(kdeglobals) && !m_terminalConfigWatcher->files().contains(kdeglobals)) {
+        m_terminalConfigWatcher->addPath(kdeglobals);
     }
+    if (!m_terminalConfigWatcher->directories().contains(configDir)) {
+        m_terminalConfigWatcher->addPath(configDir);
+    }
+}
+
+void Backend::handleTerminalConfigChanged()
+{
+    watchTerminalConfig();
 
-    // Create a combined future that waits for all checks to complete
-    auto combinedFuture = QtFuture::whenAll(futures.begin(), futures.end());
+    KSharedConfig::openConfig()->reparseConfiguration();
+    if (currentTerminalConfiguration() != m_terminalConfiguration) {
+        qDebug() << "Terminal configuration changed, probing terminal again";
+        checkTerminaljob();
+    }
+}
 
-    combinedFuture.then(this, [this, backends](const QList<QFuture<bool>> &results) {
+void Backend::checkAvailableBackends()
+{
+    // Resolving every binary we launch up front also fills the path cache
+    refreshBinaryCache(KNOWN_BINARIES).then(this, [this]() {
+        const QStringList backends = {"distrobox", "toolbox"};
         QList<QString> availableBackends;
-        for (int i = 0; i < results.size(); ++i) {
-            if (results[i].result()) {
-                availableBackends.append(backends[i]);
+        for (const QString &backend : backends) {
+            if (!m_binaryCache.value(backend).path.isEmpty()) {
+                availableBackends.append(backend);
             }
         }
         m_cachedBackends = availableBackends;
         validatePreferredBackend();
-        Q_EMIT availableBackendsChanged(m_cachedBackends);
+        // Native builds resolve binaries right away, this runs inside the constructor then.
+        // Announce from the event loop so callers can connect first.
+        QMetaObject::invokeMethod(
+            this,
+            [this]() {
+                Q_EMIT availableBackendsChanged(m_cachedBackends);
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+QFuture<void> Backend::refreshBinaryCache(const QStringList &binaries)
+{
+    if (!m_isFlatpak) {
+        const QString path = qEnvironmentVariable("PATH");
+        if (path != m_binaryCachePath) {
+            m_binaryCache.clear();
+            m_binaryCachePath = path;
+        }
+
+        for (const QString &binary : binaries) {
+            ResolvedBinary resolved;
+            resolved.path = QStandardPaths::findExecutable(binary);
+            if (!resolved.path.isEmpty()) {
+                resolved.mtime = QFileInfo(resolved.path).lastModified().toSecsSinceEpoch();
+            }
+            m_binaryCache.insert(binary, resolved);
+        }
+        return QtFuture::makeReadyVoidFuture();
+    }
+
+    // One host round-trip for the host PATH plus the location and mtime of every binary
+    const QString script = QStringLiteral(
+        "printf '%s\\n' \"$PATH\"; "
+        "for b in \"$@\"; do "
+        "p=$(command -v \"$b\") && printf '%s %s\\n' \"$(stat -L -c %Y \"$p\" 2>/dev/null || echo -1)\" \"$p\" || printf '\\n'; "
+        "done");
+
+    m_binaryCacheRefreshing = true;
+    return m_runner->run(QStringList{"sh", "-c", script, "sh"} + binaries).then(this, [this, binaries](const CommandResult &result) {
+        m_binaryCacheRefreshing = false;
+        if (!result.success()) {
+            qWarning() << "Failed to resolve host binaries:" << result.standardError.trimmed();
+            return;
+        }
+
+        const QStringList lines = result.standardOutput.split('\n');
+        const QString hostPath = lines.value(0);
+        if (hostPath != m_binaryCachePath) {
+            m_binaryCache.clear();
+            m_binaryCachePath = hostPath;
+        }
+
+        for (int i = 0; i < binaries.size(); ++i) {
+            const QString line = lines.value(i + 1);
+            const qsizetype separator = line.indexOf(' ');
+
+            ResolvedBinary resolved;
+            if (separator > 0) {
+                resolved.mtime = line.left(separator).toLongLong();
+                resolved.path = line.mid(separator + 1);
+            }
+            m_binaryCache.insert(binaries[i], resolved);
+        }
+        m_binaryCacheAge.start();
     });
 }
 
+bool Backend::lookupBinaryCache(const QString &binary, QString *path)
+{
+    const auto it = m_binaryCache.constFind(binary);
+    if (it == m_binaryCache.constEnd()) {
+        return false;
+    }
+
+    if (m_isFlatpak) {
+        // Host files cannot be stat'ed from the sandbox. Serve the cached path
+        // and revalidate PATH and mtimes in the background once it got old.
+        if (m_binaryCacheAge.isValid() && m_binaryCacheAge.hasExpired(BINARY_CACHE_REVALIDATE_MS) && !m_binaryCacheRefreshing) {
+            refreshBinaryCache(m_binaryCache.keys());
+        }
+        if (it->path.isEmpty()) {
+            return false;
+        }
+    } else {
+        if (it->path.isEmpty() || qEnvironmentVariable("PATH") != m_binaryCachePath) {
+            return false;
+        }
+        if (QFileInfo(it->path).lastModified().toSecsSinceEpoch() != it->mtime) {
+            return false;
+        }
+    }
+
+    *path = it->path;
+    return true;
+}
+
 QStringList Backend::availableBackends() const
 {
     return m_cachedBackends;
@@ -113,23 +288,40 @@ void Backend::validatePreferredBackend()
     }
 }
 
-QString Backend::runCommand(const QStringList &command) const
+QFuture<QString> Backend::runCommand(const QStringList &command) const
 {
-    QProcess process;
-    QStringList actualCommand;
+    return m_runner->run(command).then([](const CommandResult &result) -> QString {
+        if (result.timedOut) {
+            return i18n("Error: Command timed out");
+        }
+        return result.standardOutput.trimmed();
+    });
+}
 
-    if (m_isFlatpak) {
-        // Prepend with flatpak-spawn if running as Flatpak
-        actualCommand << "flatpak-spawn" << "--host" << command;
-    } else {
-        actualCommand = command;
-    }
+quint64 Backend::runQueued(const QString &containerName,
+                           const QString &title,
+                           const QStringList &command,
+                           const JobCallback &onFinished,
+                           const QString &group)
+{
+    const quint64 id = m_jobScheduler->enqueue(containerName, title, command, group);
+    m_jobCallbacks.insert(id, onFinished);
+    return id;
+}
 
-    process.start(actualCommand[0], actualCommand.mid(1));
-    if (!process.waitForFinished(60000)) {
-        return i18n("Error: Command timed out");
-    }
-    return process.readAllStandardOutput().trimmed();
+JobScheduler *Backend::jobScheduler() const
+{
+    return m_jobScheduler;
+}
+
+ContainerStatsSampler *Backend::statsSampler() const
+{
+    return m_statsSampler;
+}
+
+ContainerSizeCache *Backend::containerSizes() const
+{
+    return m_sizeCache;
 }
 
 QString Backend::getContainerDistro(const QString &containerName) const
@@ -137,168 +329,364 @@ QString Backend::getContainerDistro(const QString &containerName) const
     if (containerName.isEmpty())
         return "";
 
-    for (const auto &container : m_currentContainers) {
-        if (container["name"] == containerName) {
-            return PackageManager::getDistroFromImage(container["image"]);
-        }
+    if (const ContainerInfo *container = findContainer(containerName)) {
+        // What the container reports beats a guess from the image name
+        const QString family = m_osReleases->packageFamily(container->id);
+        return family.isEmpty() ? PackageManager::getDistroFromImage(container->image) : family;
     }
     return "";
 }
 
-void Backend::fetchContainersAsync()
+const ContainerInfo *Backend::findContainer(const QString &containerName) const
 {
-    auto *process = new QProcess(this);
-    process->setProcessChannelMode(QProcess::MergedChannels);
+    for (auto it = m_containersByBackend.cbegin(); it != m_containersByBackend.cend(); ++it) {
+        for (const ContainerInfo &container : it.value()) {
+            if (container.name == containerName)
+                return &container;
+        }
+    }
+    return nullptr;
+}
 
-    QStringList command;
-    if (m_preferredBackend == "distrobox") {
-        command = {"distrobox", "list", "--no-color"};
-    } else if (m_preferredBackend == "toolbox") {
-        command = {"toolbox", "list", "-c"};
-    } else {
+QString Backend::backendFor(const QString &containerName) const
+{
+    const ContainerInfo *container = findContainer(containerName);
+    return container && !container->backend.isEmpty() ? container->backend.toString() : m_preferredBackend;
+}
+
+QString Backend::containerFilter() const
+{
+    return m_listAllBackends ? AllBackends : m_preferredBackend;
+}
+
+void Backend::setContainerFilter(const QString &filter)
+{
+    const bool listAll = filter == AllBackends;
+    if (!listAll)
+        setPreferredBackend(filter);
+
+    if (listAll != m_listAllBackends) {
+        m_listAllBackends = listAll;
+        QSettings settings;
+        settings.setValue("container/listAllBackends", listAll);
+    }
+
+    // Whatever is cached for the new selection shows up right away, a refresh brings it up to date
+    emit containersFetched(visibleContainers());
+}
+
+QStringList Backend::listedBackends() const
+{
+    QStringList backends;
+    for (const QString &backend : {QStringLiteral("distrobox"), QStringLiteral("toolbox")}) {
+        if (m_listAllBackends ? m_cachedBackends.contains(backend) : backend == m_preferredBackend)
+            backends << backend;
+    }
+    return backends;
+}
+
+ContainerList Backend::visibleContainers() const
+{
+    ContainerList containers;
+    for (const QString &backend : listedBackends()) {
+        containers += m_containersByBackend.value(backend);
+    }
+    return containers;
+}
+
+ContainerEventWatcher *Backend::eventWatcher(const QString &backend)
+{
+    ContainerEventWatcher *&watcher = m_eventWatchers[backend];
+    if (!watcher) {
+        watcher = new ContainerEventWatcher(m_runner, this);
+        connect(watcher, &ContainerEventWatcher::containerEvent, this, [this, backend](const QString &action, const ContainerInfo &event) {
+            applyContainerEvent(backend, action, event);
+        });
+        connect(watcher, &ContainerEventWatcher::resyncNeeded, this, [this, backend]() {
+            fetchBackendContainers(backend);
+        });
+    }
+    return watcher;
+}
+
+void Backend::fetchContainersAsync()
+{
+    const QStringList backends = listedBackends();
+    if (backends.isEmpty()) {
         emit containersFetched({});
         return;
     }
 
-    // Apply Flatpak wrapper if needed
-    QStringList actualCommand;
-    if (m_isFlatpak) {
-        actualCommand << "flatpak-spawn" << "--host" << command;
-    } else {
-        actualCommand = command;
+    for (auto it = m_eventWatchers.cbegin(); it != m_eventWatchers.cend(); ++it) {
+        if (!backends.contains(it.key()))
+            it.value()->stop();
     }
 
-    process->start(actualCommand[0], actualCommand.mid(1));
+    // Backends are queried side by side, each result is merged in as it arrives
+    for (const QString &backend : backends) {
+        // Later changes, also those made outside Kontainer, arrive through the event stream
+        eventWatcher(backend)->watch(containerManager(backend), backend);
+        fetchBackendContainers(backend);
+    }
+}
+
+// Whether a failed JSON listing means the runtime does not know --format json at all,
+// as opposed to a transient error such as a stopped podman socket
+static bool rejectsJsonFormat(const CommandResult &result)
+{
+    if (!result.started || result.timedOut || result.cancelled)
+        return false;
+    // docker before 23 takes "json" as a Go template and prints it literally
+    if (result.success())
+        return true;
+    // Runtimes without the flag, or with a template parser that chokes on it
+    const QString error = result.standardError;
+    return error.contains("unknown flag", Qt::CaseInsensitive) || error.contains("template:", Qt::CaseInsensitive);
+}
+
+void Backend::fetchBackendContainers(const QString &backend)
+{
+    const QString manager = containerManager(backend);
+    if (m_jsonUnsupportedManagers.contains(manager)) {
+        fetchContainersFromTable(backend);
+        return;
+    }
 
-    connect(process, &QProcess::finished, this, [this, process](int exitCode, QProcess::ExitStatus exitStatus) {
-        QList<QMap<QString, QString>> containers;
+    // Ask the runtime directly, filtered on the labels distrobox and toolbox put on their containers
+    const QStringList command = ContainerListParser::runtimeListCommand(manager, backend);
+    m_runner->run(command).then(this, [this, backend, manager](const CommandResult &result) {
+        bool ok = false;
+        ContainerList containers;
+        if (result.success()) {
+            containers = ContainerListParser::parseRuntimeJson(result.standardOutput, &ok);
+        }
 
-        if (exitStatus != QProcess::NormalExit || exitCode != 0) {
-            emit containersFetched({});
-            process->deleteLater();
+        if (!ok) {
+            qWarning() << "Structured container listing failed, falling back to" << backend << "list:" << result.standardError.trimmed();
+            // Anything else may be gone by the next refresh, only this listing uses the table
+            if (rejectsJsonFormat(result))
+                m_jsonUnsupportedManagers.insert(manager);
+            fetchContainersFromTable(backend);
             return;
         }
 
-        QString output = QString::fromUtf8(process->readAllStandardOutput());
-        QStringList lines = output.split('\n', Qt::SkipEmptyParts);
+        storeBackendContainers(backend, finishContainerList(containers, backend));
+    });
+}
+
+void Backend::fetchContainersFromTable(const QString &backend)
+{
+    QStringList command;
+    if (backend == "distrobox") {
+        command = {"distrobox", "list", "--no-color"};
+    } else {
+        command = {"toolbox", "list", "-c"};
+    }
 
-        if (lines.isEmpty()) {
-            emit containersFetched({});
-            process->deleteLater();
+    m_runner->run(command, QProcess::MergedChannels).then(this, [this, backend](const CommandResult &result) {
+        if (!result.started) {
+            qWarning() << "Failed to fetch containers: could not start" << result.command.value(0);
+        }
+
+        if (!result.success()) {
+            storeBackendContainers(backend, {});
             return;
         }
 
-        if (m_preferredBackend == "distrobox") {
-            // Pipe-separated table (with header)
-            QStringList headers;
-            for (const QString &col : lines[0].split('|', Qt::SkipEmptyParts)) {
-                headers << col.trimmed();
-            }
+        const ContainerList containers = backend == "distrobox" ? ContainerListParser::parseDistroboxTable(result.standardOutput)
+                                                                : ContainerListParser::parseToolboxTable(result.standardOutput);
+        storeBackendContainers(backend, finishContainerList(containers, backend));
+    });
+}
 
-            for (int i = 1; i < lines.size(); ++i) {
-                QStringList parts;
-                for (const QString &col : lines[i].split('|', Qt::SkipEmptyParts)) {
-                    parts << col.trimmed();
-                }
+void Backend::storeBackendContainers(const QString &backend, const ContainerList &containers)
+{
+    // Kept even when the backend is not shown at the moment, switching to it is instant then
+    m_containersByBackend.insert(backend, containers);
+    if (listedBackends().contains(backend))
+        emit containersFetched(visibleContainers());
+}
 
-                if (parts.size() < headers.size())
-                    continue;
+QString Backend::containerSnapshotPath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/containers.snapshot");
+}
 
-                QMap<QString, QString> container;
-                container["id"] = parts[headers.indexOf("ID")];
-                container["name"] = parts[headers.indexOf("NAME")];
-                container["status"] = parts[headers.indexOf("STATUS")];
-                container["image"] = parts[headers.indexOf("IMAGE")];
-                container["distro"] = parseDistroFromImage(container["image"]);
-                container["icon"] = getDistroIcon(container["distro"]);
+ContainerList Backend::loadContainerSnapshot()
+{
+    QFile file(containerSnapshotPath());
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
 
-                containers << container;
-            }
-        } else if (m_preferredBackend == "toolbox") {
-            // Toolbox format: ID NAME CREATED STATUS IMAGE
-            for (int i = 1; i < lines.size(); ++i) {
-                QString line = lines[i].trimmed();
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+        return {};
 
-                // Split on two or more spaces to handle the column formatting
-                QStringList parts = line.split(QRegularExpression("\\s{2,}"), Qt::SkipEmptyParts);
+    stream.setVersion(QDataStream::Qt_6_0);
+    QHash<QString, ContainerList> containers;
+    stream >> containers;
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Ignoring unreadable container snapshot" << file.fileName();
+        return {};
+    }
 
-                // Need at least ID, NAME, and IMAGE (some columns might be missing)
-                if (parts.size() < 3)
-                    continue;
+    // Operations can already work on the snapshot until the live lists replace it
+    m_containersByBackend = containers;
 
-                QMap<QString, QString> container;
+    // Backends are only detected later on, "All" shows every backend the snapshot has
+    ContainerList snapshot;
+    for (const QString &backend : {QStringLiteral("distrobox"), QStringLiteral("toolbox")}) {
+        if (m_listAllBackends ? containers.contains(backend) : backend == m_preferredBackend)
+            snapshot += containers.value(backend);
+    }
+    return snapshot;
+}
 
-                // First part is always ID
-                container["id"] = parts[0].trimmed();
+void Backend::saveContainerSnapshot()
+{
+    const QString path = containerSnapshotPath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
 
-                // Second part is NAME (might be followed by CREATED/STATUS)
-                container["name"] = parts[1].trimmed();
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not write container snapshot" << path << file.errorString();
+        return;
+    }
 
-                // Last part is always IMAGE
-                container["image"] = parts.last().trimmed();
+    QDataStream stream(&file);
+    stream << SNAPSHOT_MAGIC << SNAPSHOT_VERSION;
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << m_containersByBackend;
+    if (!file.commit())
+        qWarning() << "Could not write container snapshot" << path << file.errorString();
+}
 
-                // Set default status
-                container["status"] = "running";
+bool Backend::isWatchingContainers() const
+{
+    const QStringList backends = listedBackends();
+    return !backends.isEmpty() && std::all_of(backends.cbegin(), backends.cend(), [this](const QString &backend) {
+        const ContainerEventWatcher *watcher = m_eventWatchers.value(backend);
+        return watcher && watcher->isActive();
+    });
+}
 
-                container["distro"] = getDistroFromToolboxImage(container["image"]);
-                container["icon"] = getDistroIcon(container["distro"]);
+void Backend::refreshUnlessWatched()
+{
+    if (!isWatchingContainers())
+        fetchContainersAsync();
+}
 
-                containers << container;
-            }
+void Backend::applyContainerEvent(const QString &backend, const QString &action, const ContainerInfo &event)
+{
+    ContainerList &containers = m_containersByBackend[backend];
+
+    qsizetype row = -1;
+    for (qsizetype i = 0; i < containers.size(); ++i) {
+        const ContainerInfo &container = containers.at(i);
+        if ((!event.id.isEmpty() && container.id == event.id) || (container.id.isEmpty() && container.name == event.name)) {
+            row = i;
+            break;
         }
+    }
 
-        emit containersFetched(containers);
-        process->deleteLater();
-    });
+    if (action == "remove") {
+        if (row < 0)
+            return;
+        containers.removeAt(row);
+    } else if (action == "create") {
+        if (row >= 0)
+            return;
+        ContainerInfo container = event;
+        container.status = ContainerInfo::Status::Created;
+        container.statusText = QStringLiteral("Created");
+        container.created = QDateTime::currentDateTime().toString(Qt::ISODate);
+        containers.append(finishContainerList({container}, backend).first());
+    } else {
+        if (row < 0)
+            return;
 
-    // Handle error case
-    connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
-        qWarning() << "Failed to fetch containers:" << process->errorString();
-        emit containersFetched({});
-        process->deleteLater();
-    });
+        ContainerInfo &container = containers[row];
+        if (action == "start" || action == "unpause") {
+            container.status = ContainerInfo::Status::Running;
+            container.statusText = QStringLiteral("Up");
+        } else if (action == "stop" || action == "died") {
+            container.status = ContainerInfo::Status::Exited;
+            container.statusText = QStringLiteral("Exited");
+        } else if (action == "pause") {
+            container.status = ContainerInfo::Status::Paused;
+            container.statusText = QStringLiteral("Paused");
+        } else if (action == "rename" && !event.name.isEmpty()) {
+            container.name = event.name;
+        } else {
+            return;
+        }
+    }
+
+    m_eventFlushTimer->start();
 }
 
-QString Backend::createContainer(const QString &name, const QString &image, const QString &home, bool init, const QStringList &volumes)
+ContainerList Backend::finishContainerList(ContainerList containers, const QString &backend) const
 {
-    emit containerCreationStarted();
+    const InternedString backendId(backend);
+
+    // Containers usually share a handful of images, resolve each image once
+    QHash<QString, std::pair<InternedString, InternedString>> resolved;
+    for (ContainerInfo &container : containers) {
+        container.backend = backendId;
+
+        const QString probed = m_osReleases->distro(container.id);
+        container.osName = m_osReleases->osRelease(container.id).prettyName;
+        if (!probed.isEmpty()) {
+            container.distro = InternedString(probed);
+            container.icon = InternedString(getDistroIcon(probed));
+            continue;
+        }
 
-    m_createProcess = new QProcess(this);
-    m_createProcess->setProcessChannelMode(QProcess::MergedChannels);
+        auto it = resolved.find(container.image);
+        if (it == resolved.end()) {
+            const QString distro = backend == "toolbox" ? getDistroFromToolboxImage(container.image) : parseDistroFromImage(container.image);
+            it = resolved.insert(container.image, {InternedString(distro), InternedString(getDistroIcon(distro))});
+        }
+        container.distro = it->first;
+        container.icon = it->second;
+    }
+    return containers;
+}
 
-    QString result;
-    bool success = false;
-    QEventLoop loop;
+void Backend::applyOsReleases(const QStringList &ids)
+{
+    const QSet<QString> probed(ids.cbegin(), ids.cend());
+    for (auto it = m_containersByBackend.begin(); it != m_containersByBackend.end(); ++it) {
+        for (ContainerInfo &container : it.value()) {
+            if (!probed.contains(container.id))
+                continue;
 
-    // Collect all output
-    QString output;
-    connect(m_createProcess, &QProcess::readyReadStandardOutput, this, [this, &output]() {
-        QString text = QString::fromUtf8(m_createProcess->readAllStandardOutput());
-        output += text;
-        emit containerOutput(text);
-    });
+            container.osName = m_osReleases->osRelease(container.id).prettyName;
+            const QString distro = m_osReleases->distro(container.id);
+            if (!distro.isEmpty()) {
+                container.distro = InternedString(distro);
+                container.icon = InternedString(getDistroIcon(distro));
+            }
+        }
+    }
+    m_eventFlushTimer->start();
+}
 
-    connect(m_createProcess, &QProcess::readyReadStandardError, this, [this, &output]() {
-        QString text = QString::fromUtf8(m_createProcess->readAllStandardError());
-        output += text;
-        emit containerOutput(text);
-    });
+ContainerCreationJob *Backend::createContainer(const QString &name, const QString &image, const QString &home, bool init, const QStringList &volumes)
+{
+    QList<ContainerCreationJob::Step> steps;
+    const QString manager = containerManager();
 
-    connect(m_createProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [&](int exitCode, QProcess::ExitStatus exitStatus) {
-        success = (exitStatus == QProcess::NormalExit && exitCode == 0);
-        output += QString::fromUtf8(m_createProcess->readAllStandardOutput());
-        output += QString::fromUtf8(m_createProcess->readAllStandardError());
-        loop.quit();
-    });
+    // Pulling on its own gives the slowest part separate progress and timing.
+    // An image already in storage needs no registry round-trip at all.
+    if (!m_localImages->contains(manager, image))
+        steps.append({ContainerCreationJob::Pull, {manager, "pull", image}});
 
-    // Build args
-    QStringList args;
     if (m_preferredBackend == "distrobox") {
-        args = {m_isFlatpak ? "flatpak-spawn" : "distrobox"};
-        if (m_isFlatpak)
-            args << "--host" << "distrobox";
-        args << "create" << "-n" << name << "-i" << image << "-Y";
-
+        QStringList args = {"distrobox", "create", "-n", name, "-i", image, "-Y"};
         if (init)
             args << "--init" << "--additional-packages" << "systemd";
         if (!home.isEmpty())
@@ -306,42 +694,79 @@ QString Backend::createContainer(const QString &name, const QString &image, cons
         for (const QString &v : volumes)
             args << "--volume" << v;
 
+        steps.append({ContainerCreationJob::Create, args});
+        steps.append({ContainerCreationJob::Init, {manager, "start", name}});
+        // distrobox provisions the container on its first enter, do it here instead of in the terminal
+        steps.append({ContainerCreationJob::FirstEnter, {"distrobox", "enter", name, "--", "true"}});
     } else if (m_preferredBackend == "toolbox") {
-        args = {m_isFlatpak ? "flatpak-spawn" : "toolbox"};
-        if (m_isFlatpak)
-            args << "--host" << "toolbox";
-        args << "create" << "-c" << name << "-i" << image << "-y";
-
+        steps.append({ContainerCreationJob::Create, {"toolbox", "create", "-c", name, "-i", image, "-y"}});
+        steps.append({ContainerCreationJob::Init, {manager, "start", name}});
+        steps.append({ContainerCreationJob::FirstEnter, {"toolbox", "run", "-c", name, "true"}});
     } else {
-        return i18n("Error: No supported backend available");
+        return nullptr;
     }
 
-    // Start the process
-    m_createProcess->start(args.first(), args.mid(1));
-    if (!m_createProcess->waitForStarted()) {
-        return i18n("Error: Failed to start container creation process");
-    }
+    // A container of that name that is already there makes the create fail, it is not ours to remove
+    const bool nameTaken = findContainer(name) != nullptr;
+
+    auto *job = new ContainerCreationJob(m_runner, name, steps, this);
+    connect(job, &ContainerCreationJob::finished, this, [this, job, name, nameTaken](bool success, bool cancelled, const QString &) {
+        // The pull, or the create command itself, may have stored a new image
+        m_localImages->invalidate();
+        // Nothing exists yet if the pull was interrupted, after a finished create it is ours for sure
+        const ContainerCreationJob::Phase phase = job->phase();
+        const bool created = phase > ContainerCreationJob::Create || (phase == ContainerCreationJob::Create && !nameTaken);
+        if (cancelled && created) {
+            removePartialContainer(name);
+        } else if (success) {
+            refreshUnlessWatched();
+        }
+    });
+    return job;
+}
 
-    loop.exec();
+QString Backend::containerManager() const
+{
+    return containerManager(m_preferredBackend);
+}
 
-    QString message = success ? i18n("Container created successfully") : i18n("Container creation failed");
-    emit containerCreationFinished(success, message + "\n\n" + output);
+QString Backend::containerManager(const QString &backend) const
+{
+    if (backend == "distrobox" && m_binaryCache.value("podman").path.isEmpty() && !m_binaryCache.value("docker").path.isEmpty()) {
+        return "docker";
+    }
+    return "podman";
+}
 
-    m_createProcess->deleteLater();
-    m_createProcess = nullptr;
+void Backend::removePartialContainer(const QString &name)
+{
+    const QString backend = backendFor(name);
+    QStringList command;
+    if (backend == "distrobox") {
+        command = {"distrobox", "rm", "--force", name};
+    } else if (backend == "toolbox") {
+        command = {"toolbox", "rm", "--force", name};
+    } else {
+        return;
+    }
 
-    return success ? message : i18n("Error: ") + output;
+    // The container may not exist yet if the image pull was interrupted, failure is expected then
+    m_runner->run(command, QProcess::MergedChannels).then(this, [this, name](const CommandResult &result) {
+        if (result.success()) {
+            qDebug() << "Removed partially created container" << name;
+        }
+        refreshUnlessWatched();
+    });
 }
 
-
 void Backend::deleteContainer(const QString &name)
 {
+    const QString backend = backendFor(name);
     QString appsPath;
 
-    if (m_preferredBackend == "distrobox") {
-        QString bin = resolveBinaryPath("distrobox");
-        executeInTerminal(QString("%1 rm %2 --force").arg(bin, name));
-    } else if (m_preferredBackend == "toolbox") {
+    if (backend == "distrobox") {
+        executeResolvedInTerminal("distrobox", QString("rm %1 --force").arg(name));
+    } else if (backend == "toolbox") {
         // First remove all exported desktop files for this container
         if (m_isFlatpak) {
             // Access host's ~/.local/share/applications manually
@@ -359,30 +784,36 @@ void Backend::deleteContainer(const QString &name)
         }
 
         // Update desktop database after removal
-        QString updateResult = runCommand({"update-desktop-database", appsDir.path()});
-        if (updateResult.startsWith("Error:")) {
-            qWarning() << "Failed to update desktop database:" << updateResult;
-        }
+        runCommand({"update-desktop-database", appsDir.path()}).then([](const QString &updateResult) {
+            if (updateResult.startsWith("Error:")) {
+                qWarning() << "Failed to update desktop database:" << updateResult;
+            }
+        });
 
         // Now remove the container
-        QString bin = resolveBinaryPath("toolbox");
-        executeInTerminal(QString("%1 rm %2 --force").arg(bin, name));
+        executeResolvedInTerminal("toolbox", QString("rm %1 --force").arg(name));
     }
 }
 
-QString Backend::resolveBinaryPath(const QString &binary)
+QFuture<QString> Backend::resolveBinaryPath(const QString &binary)
 {
     // Hack needed for distrobox as KTerminalLauncherJob doesnt seem to want to launch it without full path
-    if (m_isFlatpak) {
-        QProcess proc;
-        proc.start("flatpak-spawn", {"--host", "which", binary});
-        proc.waitForFinished();
-        QString output = QString::fromUtf8(proc.readAllStandardOutput()).trimmed();
-        return output.isEmpty() ? binary : output;
-    } else {
-        QString path = QStandardPaths::findExecutable(binary);
-        return path.isEmpty() ? binary : path;
+    QString path;
+    if (lookupBinaryCache(binary, &path)) {
+        return QtFuture::makeReadyValueFuture(path);
     }
+
+    return refreshBinaryCache({binary}).then(this, [this, binary]() {
+        const QString path = m_binaryCache.value(binary).path;
+        return path.isEmpty() ? binary : path;
+    });
+}
+
+void Backend::executeResolvedInTerminal(const QString &binary, const QString &arguments)
+{
+    resolveBinaryPath(binary).then(this, [this, arguments](const QString &bin) {
+        executeInTerminal(bin + " " + arguments);
+    });
 }
 
 void Backend::executeInTerminal(const QString &command)
@@ -399,328 +830,226 @@ void Backend::executeInTerminal(const QString &command)
 
 void Backend::enterContainer(const QString &name)
 {
-    if (m_preferredBackend == "distrobox") {
-        QString bin = resolveBinaryPath("distrobox");
-        executeInTerminal(bin + " enter " + name);
-    } else if (m_preferredBackend == "toolbox") {
-        QString bin = resolveBinaryPath("toolbox");
-        executeInTerminal(bin + " enter " + name);
+    const QString backend = backendFor(name);
+    if (backend == "distrobox") {
+        executeResolvedInTerminal("distrobox", "enter " + name);
+    } else if (backend == "toolbox") {
+        executeResolvedInTerminal("toolbox", "enter " + name);
     }
 }
 
 void Backend::upgradeContainer(const QString &name)
 {
-    QString bin = resolveBinaryPath("distrobox-upgrade");
-    executeInTerminal(bin + " " + name);
+    executeResolvedInTerminal("distrobox-upgrade", name);
 }
 
 void Backend::upgradeAllContainers()
 {
-    QString bin = resolveBinaryPath("distrobox-upgrade");
-    executeInTerminal(bin + " --all");
+    executeResolvedInTerminal("distrobox-upgrade", "--all");
 }
 
 void Backend::installDebPackage(const QString &containerName, const QString &filePath)
 {
+    const QString backend = backendFor(containerName);
     QString command = "sudo apt install -y " + filePath;
-    if (m_preferredBackend == "distrobox") {
-        QString bin = resolveBinaryPath("distrobox");
-        executeInTerminal(bin + " enter " + containerName + " -- " + command);
-    } else if (m_preferredBackend == "toolbox") {
-        QString bin = resolveBinaryPath("toolbox");
-        executeInTerminal(bin + " run -c " + containerName + " " + command);
+    if (backend == "distrobox") {
+        executeResolvedInTerminal("distrobox", "enter " + containerName + " -- " + command);
+    } else if (backend == "toolbox") {
+        executeResolvedInTerminal("toolbox", "run -c " + containerName + " " + command);
     }
 }
 
 void Backend::installRpmPackage(const QString &containerName, const QString &filePath)
 {
+    const QString backend = backendFor(containerName);
     QString command = "sudo dnf install -y " + filePath;
-    if (m_preferredBackend == "distrobox") {
-        QString bin = resolveBinaryPath("distrobox");
-        executeInTerminal(bin + " enter " + containerName + " -- " + command);
-    } else if (m_preferredBackend == "toolbox") {
-        QString bin = resolveBinaryPath("toolbox");
-        executeInTerminal(bin + " run -c " + containerName + " " + command);
+    if (backend == "distrobox") {
+        executeResolvedInTerminal("distrobox", "enter " + containerName + " -- " + command);
+    } else if (backend == "toolbox") {
+        executeResolvedInTerminal("toolbox", "run -c " + containerName + " " + command);
     }
 }
 
 void Backend::installArchPackage(const QString &containerName, const QString &filePath)
 {
+    const QString backend = backendFor(containerName);
     QString command = "sudo pacman -U --noconfirm " + filePath;
-    if (m_preferredBackend == "distrobox") {
-        QString bin = resolveBinaryPath("distrobox");
-        executeInTerminal(bin + " enter " + containerName + " -- " + command);
-    } else if (m_preferredBackend == "toolbox") {
-        QString bin = resolveBinaryPath("toolbox");
-        executeInTerminal(bin + " run -c " + containerName + " " + command);
+    if (backend == "distrobox") {
+        executeResolvedInTerminal("distrobox", "enter " + containerName + " -- " + command);
+    } else if (backend == "toolbox") {
+        executeResolvedInTerminal("toolbox", "run -c " + containerName + " " + command);
     }
 }
 
-void Backend::assembleContainer(const QString &iniFile)
+quint64 Backend::assembleContainer(const QString &iniFile)
 {
-    QString bin = resolveBinaryPath("distrobox-assemble");
-    QString command = QString("%1 create --file \"%2\"").arg(bin, iniFile);
-
     if (isTerminalJobPossible()) {
-        executeInTerminal(command);
-        return;
+        executeResolvedInTerminal("distrobox-assemble", QString("create --file \"%1\"").arg(iniFile));
+        return 0;
     }
 
-    emit assembleStartedWithDialog();
-
-    QProcess *process = new QProcess(this);
-
-    connect(process, &QProcess::readyReadStandardOutput, this, [this, process]() {
-        QString output = QString::fromLocal8Bit(process->readAllStandardOutput());
+    const QString title = i18nc("@info %1 is an INI file", "Assemble %1", QFileInfo(iniFile).fileName());
+    return runQueued(JobScheduler::AllContainers, title, {"distrobox", "assemble", "create", "--file", iniFile}, [this, iniFile](const QString &output, const CommandResult &result) {
+        if (result.cancelled) {
+            // Take down whatever part of the manifest was already created
+            m_runner->run({"distrobox", "assemble", "rm", "--file", iniFile}, QProcess::MergedChannels).then(this, [this](const CommandResult &) {
+                refreshUnlessWatched();
+            });
+        } else {
+            refreshUnlessWatched();
+        }
         emit assembleFinished(output);
     });
-
-    connect(process, &QProcess::readyReadStandardError, this, [this, process]() {
-        QString error = QString::fromLocal8Bit(process->readAllStandardError());
-        emit assembleFinished(error);
-    });
-
-    connect(process, &QProcess::finished, process, &QProcess::deleteLater);
-
-    if (m_isFlatpak) {
-        process->start("flatpak-spawn", {"--host", "distrobox", "assemble", "create", "--file", iniFile});
-    } else {
-        process->start("distrobox", {"assemble", "create", "--file", iniFile});
-    }
 }
 
 QString Backend::getDistroFromToolboxImage(const QString &image) const
 {
-    for (const auto &entry : toolboxImages) {
-        if (entry.image == image) {
-            return entry.distro;
-        }
-    }
+    if (const DistroTable::ToolboxImage *entry = DistroTable::findToolboxImage(image))
+        return DistroTable::toQString(entry->distro);
 
     // Fallback: use regex-based parser for unknown URLs
     return parseDistroFromImage(image);
 }
 
-QList<QMap<QString, QString>> Backend::getAvailableImages()
+QFuture<ImageList> Backend::getAvailableImages(bool reload)
 {
-    QList<QMap<QString, QString>> images;
+    if (reload)
+        m_localImages->invalidate();
 
     if (m_preferredBackend == "toolbox") {
+        ImageList images;
+        images.reserve(std::size(DistroTable::TOOLBOX_IMAGES));
+
         // Handle toolbox images
-        for (const auto &entry : toolboxImages) {
-            QMap<QString, QString> image;
-            QString imageUrl = entry.image;
-            QString distro = entry.distro;
-            QString version = entry.version;
-
-            image["url"] = imageUrl;
-            image["name"] = imageUrl.split('/').last();
-            image["distro"] = distro;
-            image["version"] = version;
-            image["icon"] = getDistroIcon(distro);
-            image["display"] = QString("%1 %2").arg(distro, version);
+        for (const auto &entry : DistroTable::TOOLBOX_IMAGES) {
+            ImageInfo image;
+            QString imageUrl = DistroTable::toQString(entry.image);
+            QString distro = DistroTable::toQString(entry.distro);
+            QString version = DistroTable::toQString(entry.version);
+
+            image.url = imageUrl;
+            image.name = imageUrl.split('/').last();
+            image.distro = InternedString(distro);
+            image.version = version;
+            image.icon = InternedString(getDistroIcon(distro));
+            image.display = QString("%1 %2").arg(distro, version);
 
             images.append(image);
         }
-    } else {
-        // Handle distrobox images
-        QString output = runCommand({"distrobox", "create", "-C"});
-        for (const QString &line : output.split('\n', Qt::SkipEmptyParts)) {
-            QMap<QString, QString> image;
-            QString trimmed = line.trimmed();
-            image["url"] = trimmed;
-            image["name"] = trimmed.split('/').last();
-            image["distro"] = parseDistroFromImage(trimmed);
-            image["icon"] = getDistroIcon(image["distro"]);
-            image["display"] = trimmed;
-            images.append(image);
-        }
+
+        return mergeLocalImages(QtFuture::makeReadyValueFuture(images));
     }
 
-    return images;
+    // Handle distrobox images, listed once and then served from memory
+    return mergeLocalImages(reload ? m_imageCatalog->reload() : m_imageCatalog->images());
 }
 
-QString Backend::getDistroIcon(const QString &distroName) const
+QFuture<ImageList> Backend::mergeLocalImages(QFuture<ImageList> catalog)
 {
-    QString lowerDistro = distroName.toLower();
-
-    // First try exact match
-    if (distroIconMap.contains(lowerDistro)) {
-        return ":/icons/" + distroIconMap[lowerDistro];
-    }
-
-    // Then try partial matches
-    for (const QString &key : distroIconMap.keys()) {
-        if (lowerDistro.contains(key)) {
-            return ":/icons/" + distroIconMap[key];
-        }
-    }
-
-    // Default icon (tux)
-    return ":/icons/tux.svg";
+    // Both listings run side by side
+    QFuture<ImageList> local = m_localImages->images(containerManager());
+    return catalog
+        .then(this,
+              [this, local](const ImageList &images) {
+                  QFuture<ImageList> pending = local;
+                  return pending.then(this, [images](const ImageList &localImages) {
+                      return LocalImageInventory::merge(images, localImages);
+                  });
+              })
+        .unwrap();
 }
 
-QList<QMap<QString, QString>> Backend::searchImages(const QString &query)
+QString Backend::getDistroIcon(const QString &distroName) const
 {
-    QList<QMap<QString, QString>> allImages = getAvailableImages();
-    QList<QMap<QString, QString>> filteredImages;
-
-    for (const auto &image : allImages) {
-        if (image["name"].contains(query, Qt::CaseInsensitive) || image["distro"].contains(query, Qt::CaseInsensitive)
-            || image["url"].contains(query, Qt::CaseInsensitive)) {
-            filteredImages.append(image);
-        }
-    }
-
-    return filteredImages;
+    return DistroTable::iconPath(distroName);
 }
 
-// Modified implementation:
-void Backend::installPackageNoTerminal(const QString &containerName, const QString &filePath, const QString &packageCommand, const QString &signalName)
+quint64 Backend::installPackageNoTerminal(const QString &containerName, const QString &filePath, const QString &packageCommand, const QString &signalName)
 {
-    QtConcurrent::run([=]() {
-        QMutexLocker locker(&mutex);
-
-        QProcess process;
-        QStringList args;
-        QString fullCommand = QString("sudo %1 %2").arg(packageCommand, filePath);
-
-        if (m_preferredBackend == "distrobox") {
-            args = buildDistroboxCommand(containerName, fullCommand);
-        } else if (m_preferredBackend == "toolbox") {
-            args = buildToolboxCommand(containerName, fullCommand);
-        } else {
-            QMetaObject::invokeMethod(this, [=]() {
-                emit packageInstallFinished(signalName, i18n("Error: Unknown container backend"));
-            }, Qt::QueuedConnection);
-            return;
-        }
-
-        process.setProgram(args.first());
-        process.setArguments(args.mid(1));
-
-        QString output;
-        process.setProcessChannelMode(QProcess::MergedChannels);
-        process.start();
-        if (!process.waitForStarted()) return;
-
-        while (process.state() == QProcess::Running) {
-            process.waitForReadyRead();
-            QString chunk = QString::fromLocal8Bit(process.readAll());
-            output += chunk;
-            QMetaObject::invokeMethod(this, [=]() {
-                emit outputReceived(chunk);
-            }, Qt::QueuedConnection);
-        }
-
-        process.waitForFinished();
-        int exitCode = process.exitCode();
+    const QString backend = backendFor(containerName);
+    QStringList args;
+    QString fullCommand = QString("sudo %1 %2").arg(packageCommand, filePath);
 
-        QString result = output;
-        if (exitCode != 0) {
-            result += i18n("\nError: Command failed with exit code %1").arg(exitCode);
-        }
+    if (backend == "distrobox") {
+        args = buildDistroboxCommand(containerName, fullCommand);
+    } else if (backend == "toolbox") {
+        args = buildToolboxCommand(containerName, fullCommand);
+    } else {
+        emit packageInstallFinished(signalName, i18n("Error: Unknown container backend"));
+        return 0;
+    }
 
-        QMetaObject::invokeMethod(this, [=]() {
-            if (signalName == "debInstallFinished")
-                emit debInstallFinished(result);
-            else if (signalName == "rpmInstallFinished")
-                emit rpmInstallFinished(result);
-            else if (signalName == "archInstallFinished")
-                emit archInstallFinished(result);
-            emit packageInstallFinished(signalName, result);
-        }, Qt::QueuedConnection);
+    const QString title = i18nc("@info %1 is a package file", "Install %1", QFileInfo(filePath).fileName());
+    return runQueued(containerName, title, args, [this, signalName](const QString &result, const CommandResult &) {
+        if (signalName == "debInstallFinished")
+            emit debInstallFinished(result);
+        else if (signalName == "rpmInstallFinished")
+            emit rpmInstallFinished(result);
+        else if (signalName == "archInstallFinished")
+            emit archInstallFinished(result);
+        emit packageInstallFinished(signalName, result);
     });
 }
 
-void Backend::upgradeContainerNoTerminal(const QString &containerName)
+quint64 Backend::upgradeContainerNoTerminal(const QString &containerName)
 {
-    QtConcurrent::run([=]() {
-        QMutexLocker locker(&mutex);
-
-        QProcess process;
-        QStringList args = m_isFlatpak
-        ? QStringList{"flatpak-spawn", "--host", "distrobox-upgrade", containerName}
-        : QStringList{"distrobox-upgrade", containerName};
-
-        process.setProgram(args.first());
-        process.setArguments(args.mid(1));
-        process.setProcessChannelMode(QProcess::MergedChannels);
-
-        QString output;
-        process.start();
-        if (!process.waitForStarted()) return;
-
-        while (process.state() == QProcess::Running) {
-            process.waitForReadyRead();
-            QString chunk = QString::fromLocal8Bit(process.readAll());
-            output += chunk;
-            QMetaObject::invokeMethod(this, [=]() {
-                emit outputReceived(chunk);
-            }, Qt::QueuedConnection);
-        }
-
-        process.waitForFinished();
-        int exitCode = process.exitCode();
-
-        QString result = output;
-        if (exitCode != 0) {
-            result += i18n("\nError: Command failed with exit code %1").arg(exitCode);
-        }
-
-        QMetaObject::invokeMethod(this, [=]() {
-            emit upgradeFinished(result);
-        }, Qt::QueuedConnection);
+    return runQueued(containerName, i18n("Upgrade"), {"distrobox-upgrade", containerName}, [this](const QString &result, const CommandResult &) {
+        emit upgradeFinished(result);
     });
 }
 
-void Backend::upgradeAllContainersNoTerminal()
+QList<quint64> Backend::upgradeAllContainersNoTerminal()
 {
-    QtConcurrent::run([=]() {
-        QMutexLocker locker(&mutex);
-
-        QProcess process;
-        QStringList args = m_isFlatpak
-        ? QStringList{"flatpak-spawn", "--host", "distrobox-upgrade", "--all"}
-        : QStringList{"distrobox-upgrade", "--all"};
-
-        process.setProgram(args.first());
-        process.setArguments(args.mid(1));
-        process.setProcessChannelMode(QProcess::MergedChannels);
-
-        QString output;
-        process.start();
-        if (!process.waitForStarted()) return;
-
-        while (process.state() == QProcess::Running) {
-            process.waitForReadyRead();
-            QString chunk = QString::fromLocal8Bit(process.readAll());
-            output += chunk;
-            QMetaObject::invokeMethod(this, [=]() {
-                emit outputReceived(chunk);
-            }, Qt::QueuedConnection);
-        }
-
-        process.waitForFinished();
-        int exitCode = process.exitCode();
+    // Without a parsed distrobox list fall back to letting distrobox-upgrade walk them itself
+    const ContainerList containers = m_containersByBackend.value("distrobox");
+    if (containers.isEmpty()) {
+        return {runQueued(JobScheduler::AllContainers, i18n("Upgrade all containers"), {"distrobox-upgrade", "--all"}, [this](const QString &result, const CommandResult &) {
+            emit upgradeAllFinished(result);
+        })};
+    }
 
-        QString result = output;
-        if (exitCode != 0) {
-            result += i18n("\nError: Command failed with exit code %1").arg(exitCode);
-        }
+    QHash<QString, int> imageUsers;
+    for (const auto &container : containers) {
+        ++imageUsers[container.image];
+    }
 
-        QMetaObject::invokeMethod(this, [=]() {
-            emit upgradeAllFinished(result);
-        }, Qt::QueuedConnection);
-    });
+    struct Progress {
+        int remaining = 0;
+        QStringList failed;
+    };
+    auto progress = std::make_shared<Progress>();
+    progress->remaining = containers.size();
+
+    QList<quint64> ids;
+    for (const auto &container : containers) {
+        const QString name = container.name;
+        // Containers built from the same image download the same packages, upgrade them one at a time
+        const QString group = imageUsers.value(container.image) > 1 ? QStringLiteral("image:") + container.image : QString();
+
+        ids << runQueued(
+            name,
+            i18n("Upgrade"),
+            {"distrobox-upgrade", name},
+            [this, name, progress](const QString &, const CommandResult &result) {
+                if (!result.success())
+                    progress->failed << name;
+                if (--progress->remaining > 0)
+                    return;
+
+                if (progress->failed.isEmpty()) {
+                    emit upgradeAllFinished(i18n("All containers upgraded successfully"));
+                } else {
+                    emit upgradeAllFinished(i18n("Upgrade failed for: %1", progress->failed.join(", ")));
+                }
+            },
+            group);
+    }
+    return ids;
 }
 
 QStringList Backend::buildDistroboxCommand(const QString &containerName, const QString &command)
 {
     QStringList args;
-    if (m_isFlatpak) {
-        args << "flatpak-spawn" << "--host";
-    }
     args << "distrobox" << "enter" << containerName << "--" << command.split(" ");
     return args;
 }
@@ -728,9 +1057,6 @@ QStringList Backend::buildDistroboxCommand(const QString &containerName, const Q
 QStringList Backend::buildToolboxCommand(const QString &containerName, const QString &command)
 {
     QStringList args;
-    if (m_isFlatpak) {
-        args << "flatpak-spawn" << "--host";
-    }
     args << "toolbox" << "run" << "-c" << containerName << "--";
 
     // Handle quoted paths properly
@@ -742,52 +1068,24 @@ QStringList Backend::buildToolboxCommand(const QString &containerName, const QSt
     return args;
 }
 
-void Backend::handlePackageInstallFinished(QProcess *process, int exitCode, const QString &signalName)
+quint64 Backend::installDebPackageNoTerminal(const QString &containerName, const QString &filePath)
 {
-    QString stdoutData = process->readAllStandardOutput();
-    QString stderrData = process->readAllStandardError();
-
-    qDebug() << "[handlePackageInstallFinished] Exit code:" << exitCode;
-    qDebug() << "[handlePackageInstallFinished] Stdout:" << stdoutData;
-    qDebug() << "[handlePackageInstallFinished] Stderr:" << stderrData;
-
-    QString result = stdoutData;
-    if (exitCode != 0) {
-        result += "\nError: " + stderrData;
-    }
-
-    // Emit the specific signal based on signalName
-    if (signalName == "debInstallFinished") {
-        emit debInstallFinished(result);
-    } else if (signalName == "rpmInstallFinished") {
-        emit rpmInstallFinished(result);
-    } else if (signalName == "archInstallFinished") {
-        emit archInstallFinished(result);
-    }
-
-    // Also emit the generic signal
-    emit packageInstallFinished(signalName, result);
-
-    process->deleteLater();
-}
-
-void Backend::installDebPackageNoTerminal(const QString &containerName, const QString &filePath)
-{
-    installPackageNoTerminal(containerName, filePath, "apt install -y", "debInstallFinished");
+    return installPackageNoTerminal(containerName, filePath, "apt install -y", "debInstallFinished");
 }
 
-void Backend::installRpmPackageNoTerminal(const QString &containerName, const QString &filePath)
+quint64 Backend::installRpmPackageNoTerminal(const QString &containerName, const QString &filePath)
 {
-    installPackageNoTerminal(containerName, filePath, "dnf install -y", "rpmInstallFinished");
+    return installPackageNoTerminal(containerName, filePath, "dnf install -y", "rpmInstallFinished");
 }
 
-void Backend::installArchPackageNoTerminal(const QString &containerName, const QString &filePath)
+quint64 Backend::installArchPackageNoTerminal(const QString &containerName, const QString &filePath)
 {
-    installPackageNoTerminal(containerName, filePath, "pacman -U --noconfirm", "archInstallFinished");
+    return installPackageNoTerminal(containerName, filePath, "pacman -U --noconfirm", "archInstallFinished");
 }
 
-QStringList Backend::getAvailableApps(const QString &containerName)
+QFuture<QStringList> Backend::getAvailableApps(const QString &containerName)
 {
+    const QString backend = backendFor(containerName);
     // Find only valid .desktop files that are not NoDisplay=true
     QString findCmd =
     "find /usr/share/applications -type f -name '*.desktop' "
@@ -795,9 +1093,9 @@ QStringList Backend::getAvailableApps(const QString &containerName)
     "-exec test -f {} \\; "
     "-print";
 
-    QString output;
-    if (m_preferredBackend == "distrobox") {
-        output = runCommand({
+    QStringList command;
+    if (backend == "distrobox") {
+        command = {
             "distrobox",
             "enter",
             containerName,
@@ -807,9 +1105,9 @@ QStringList Backend::getAvailableApps(const QString &containerName)
             "--norc",
             "-c",
             findCmd
-        });
-    } else if (m_preferredBackend == "toolbox") {
-        output = runCommand({
+        };
+    } else if (backend == "toolbox") {
+        command = {
             "toolbox",
             "run",
             "-c",
@@ -819,24 +1117,26 @@ QStringList Backend::getAvailableApps(const QString &containerName)
             "--norc",
             "-c",
             findCmd
-        });
+        };
     } else {
-        return {};
+        return QtFuture::makeReadyValueFuture(QStringList());
     }
 
-    QStringList apps;
-    for (const QString &line : output.split('\n', Qt::SkipEmptyParts)) {
-        if (QFileInfo(line).isFile() && line.endsWith(".desktop")) {
-            apps << QFileInfo(line).baseName();
+    return runCommand(command).then([](const QString &output) {
+        QStringList apps;
+        for (const QString &line : output.split('\n', Qt::SkipEmptyParts)) {
+            if (QFileInfo(line).isFile() && line.endsWith(".desktop")) {
+                apps << QFileInfo(line).baseName();
+            }
         }
-    }
-
-    return apps;
+        return apps;
+    });
 }
 
 
 QStringList Backend::getExportedApps(const QString &containerName)
 {
+    const QString backend = backendFor(containerName);
     QStringList apps;
     QString appsPath;
 
@@ -849,10 +1149,10 @@ QStringList Backend::getExportedApps(const QString &containerName)
     QDir dir(appsPath);
 
     QStringList patterns;
-    if (m_preferredBackend == "toolbox") {
+    if (backend == "toolbox") {
         // Toolbox format: some-app-<container>.desktop
         patterns << QString("*-%1.desktop").arg(containerName);
-    } else if (m_preferredBackend == "distrobox") {
+    } else if (backend == "distrobox") {
         // Distrobox format: <container>-<app>.desktop
         patterns << QString("%1-*.desktop").arg(containerName);
     }
@@ -869,13 +1169,13 @@ QStringList Backend::getExportedApps(const QString &containerName)
 
         QString appId;
 
-        if (m_preferredBackend == "toolbox") {
+        if (backend == "toolbox") {
             // remove trailing "-<containerName>"
             QString suffix = "-" + containerName;
             if (fileName.endsWith(suffix)) {
                 appId = fileName.left(fileName.length() - suffix.length());
             }
-        } else if (m_preferredBackend == "distrobox") {
+        } else if (backend == "distrobox") {
             // remove leading "<containerName>-"
             QString prefix = containerName + "-";
             if (fileName.startsWith(prefix)) {
@@ -890,84 +1190,110 @@ QStringList Backend::getExportedApps(const QString &containerName)
     return apps;
 }
 
-QString Backend::exportApp(const QString &appName, const QString &containerName)
+QFuture<QString> Backend::exportApp(const QString &appName, const QString &containerName)
 {
-    if (m_preferredBackend == "distrobox") {
+    const QString backend = backendFor(containerName);
+    if (backend == "distrobox") {
         QString desktopPath = "/usr/share/applications/" + appName + ".desktop";
         return runCommand({"distrobox", "enter", containerName, "--", "distrobox-export", "--app", desktopPath});
-    } else {
-        QString checkCmd = QString("toolbox run -c %1 which %2").arg(containerName, appName);
-        if (runCommand({"sh", "-c", checkCmd}).isEmpty()) {
-            return i18nc("Error message when application is not found in container", "Application %1 not found in container %2", appName, containerName);
-        }
-
-        QString desktopFile =
-            runCommand({"toolbox", "run", "-c", containerName, "sh", "-c", QString("find /usr/share/applications -name '*%1*.desktop' | head -1").arg(appName)})
-                .trimmed();
-
-        if (desktopFile.isEmpty()) {
-            return i18nc("Error message when desktop file is not found", "Could not find desktop file for %1 in container %2", appName, containerName);
-        }
+    }
 
-        QString desktopContent = runCommand({"toolbox", "run", "-c", containerName, "cat", desktopFile});
+    QString checkCmd = QString("toolbox run -c %1 which %2").arg(containerName, appName);
+    return runCommand({"sh", "-c", checkCmd})
+        .then(this,
+              [this, appName, containerName](const QString &whichOutput) -> QFuture<QString> {
+                  if (whichOutput.isEmpty()) {
+                      return QtFuture::makeReadyValueFuture(i18nc("Error message when application is not found in container",
+                                                                  "Application %1 not found in container %2",
+                                                                  appName,
+                                                                  containerName));
+                  }
+
+                  return runCommand({"toolbox",
+                                     "run",
+                                     "-c",
+                                     containerName,
+                                     "sh",
+                                     "-c",
+                                     QString("find /usr/share/applications -name '*%1*.desktop' | head -1").arg(appName)})
+                      .then(this,
+                            [this, appName, containerName](const QString &desktopFile) -> QFuture<QString> {
+                                if (desktopFile.isEmpty()) {
+                                    return QtFuture::makeReadyValueFuture(i18nc("Error message when desktop file is not found",
+                                                                                "Could not find desktop file for %1 in container %2",
+                                                                                appName,
+                                                                                containerName));
+                                }
+
+                                return runCommand({"toolbox", "run", "-c", containerName, "cat", desktopFile})
+                                    .then(this, [this, appName, containerName, desktopFile](const QString &desktopContent) {
+                                        return writeToolboxDesktopFile(appName, containerName, desktopFile, desktopContent);
+                                    });
+                            })
+                      .unwrap();
+              })
+        .unwrap();
+}
 
-        QString appsPath;
+QString Backend::writeToolboxDesktopFile(const QString &appName, const QString &containerName, const QString &desktopFile, const QString &desktopContent)
+{
+    QString appsPath;
 
-        if (m_isFlatpak) {
-            QString home = qEnvironmentVariable("HOME");
-            appsPath = home + "/.local/share/applications";
-        } else {
-            appsPath = QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation);
-        }
+    if (m_isFlatpak) {
+        QString home = qEnvironmentVariable("HOME");
+        appsPath = home + "/.local/share/applications";
+    } else {
+        appsPath = QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation);
+    }
 
-        QString exportedPath = appsPath + "/" + QFileInfo(desktopFile).completeBaseName() + "-" + containerName + ".desktop";
-
-        QStringList lines = desktopContent.split('\n');
-        QStringList newLines;
-        bool hasNameTranslations = false;
-
-        for (QString line : lines) {
-            if (line.startsWith("Exec=")) {
-                line = QString("Exec=toolbox run -c %1 %2").arg(containerName, line.mid(5));
-            } else if (line.startsWith("Name=")) {
-                line = QString("Name=%1 (on %2)").arg(line.mid(5), containerName);
-            } else if (line.startsWith("Name[")) {
-                hasNameTranslations = true;
-            } else if (line.startsWith("GenericName=")) {
-                line = QString("GenericName=%1 (on %2)").arg(line.mid(12), containerName);
-            } else if (line.startsWith("TryExec=") || line == "DBusActivatable=true") {
-                continue;
-            }
-            newLines << line;
+    QString exportedPath = appsPath + "/" + QFileInfo(desktopFile).completeBaseName() + "-" + containerName + ".desktop";
+
+    QStringList lines = desktopContent.split('\n');
+    QStringList newLines;
+    bool hasNameTranslations = false;
+
+    for (QString line : lines) {
+        if (line.startsWith("Exec=")) {
+            line = QString("Exec=toolbox run -c %1 %2").arg(containerName, line.mid(5));
+        } else if (line.startsWith("Name=")) {
+            line = QString("Name=%1 (on %2)").arg(line.mid(5), containerName);
+        } else if (line.startsWith("Name[")) {
+            hasNameTranslations = true;
+        } else if (line.startsWith("GenericName=")) {
+            line = QString("GenericName=%1 (on %2)").arg(line.mid(12), containerName);
+        } else if (line.startsWith("TryExec=") || line == "DBusActivatable=true") {
+            continue;
         }
+        newLines << line;
+    }
 
-        if (hasNameTranslations) {
-            for (int i = 0; i < newLines.size(); i++) {
-                if (newLines[i].startsWith("Name[")) {
-                    QString lang = newLines[i].section('[', 1).section(']', 0, 0);
-                    QString value = newLines[i].section('=', 1);
-                    newLines[i] = QString("Name[%1]=%2 (on %3)").arg(lang, value, containerName);
-                }
+    if (hasNameTranslations) {
+        for (int i = 0; i < newLines.size(); i++) {
+            if (newLines[i].startsWith("Name[")) {
+                QString lang = newLines[i].section('[', 1).section(']', 0, 0);
+                QString value = newLines[i].section('=', 1);
+                newLines[i] = QString("Name[%1]=%2 (on %3)").arg(lang, value, containerName);
             }
         }
+    }
 
-        QFile file(exportedPath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            return i18nc("Error message when desktop file creation fails", "Failed to create desktop file: %1", exportedPath);
-        }
+    QFile file(exportedPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return i18nc("Error message when desktop file creation fails", "Failed to create desktop file: %1", exportedPath);
+    }
 
-        QTextStream out(&file);
-        out << newLines.join('\n');
-        file.close();
+    QTextStream out(&file);
+    out << newLines.join('\n');
+    file.close();
 
-        runCommand({"update-desktop-database", appsPath});
+    runCommand({"update-desktop-database", appsPath});
 
-        return i18nc("Success message after exporting application", "Successfully exported %1 from %2", appName, containerName);
-    }
+    return i18nc("Success message after exporting application", "Successfully exported %1 from %2", appName, containerName);
 }
 
-QString Backend::unexportApp(const QString &appName, const QString &containerName)
+QFuture<QString> Backend::unexportApp(const QString &appName, const QString &containerName)
 {
+    const QString backend = backendFor(containerName);
     QString appsPath;
 
     if (m_isFlatpak) {
@@ -978,9 +1304,9 @@ QString Backend::unexportApp(const QString &appName, const QString &containerNam
 
     QString fileName;
 
-    if (m_preferredBackend == "toolbox") {
+    if (backend == "toolbox") {
         fileName = QString("%1-%2.desktop").arg(appName, containerName);
-    } else if (m_preferredBackend == "distrobox") {
+    } else if (backend == "distrobox") {
         fileName = QString("%1-%2.desktop").arg(containerName, appName);
     } else {
         fileName = QString("%1-%2.desktop").arg(appName, containerName);
@@ -989,78 +1315,20 @@ QString Backend::unexportApp(const QString &appName, const QString &containerNam
     QString exportedFile = appsPath + "/" + fileName;
 
     if (!QFile::exists(exportedFile)) {
-        return i18nc("Error message when no exported app is found", "No exported application %1 found for container %2", appName, containerName);
+        return QtFuture::makeReadyValueFuture(
+            i18nc("Error message when no exported app is found", "No exported application %1 found for container %2", appName, containerName));
     }
 
     if (!QFile::remove(exportedFile)) {
-        return i18nc("Error message when desktop file removal fails", "Failed to remove desktop file: %1", exportedFile);
+        return QtFuture::makeReadyValueFuture(i18nc("Error message when desktop file removal fails", "Failed to remove desktop file: %1", exportedFile));
     }
 
-    runCommand({"update-desktop-database", appsPath});
-
-    return i18nc("Success message after unexporting application", "Successfully unexported %1 from %2", appName, containerName);
+    return runCommand({"update-desktop-database", appsPath}).then([appName, containerName](const QString &) {
+        return i18nc("Success message after unexporting application", "Successfully unexported %1 from %2", appName, containerName);
+    });
 }
 
 QString Backend::parseDistroFromImage(const QString &imageUrl) const
 {
-    QString image = imageUrl.toLower();
-
-    // First check hardcoded URL mappings (prefix matches)
-    static const QMap<QString, QString> hardcodedMappings = {{"ghcr.io/vanilla-os/vso:main", "vso"},
-                                                             {"docker.io/blackarchlinux/blackarch:latest", "blackarch"},
-                                                             {"cgr.dev/chainguard/wolfi-base", "wolfi"}};
-
-    // Check for exact matches first
-    for (auto it = hardcodedMappings.constBegin(); it != hardcodedMappings.constEnd(); ++it) {
-        if (image.startsWith(it.key())) {
-            return it.value();
-        }
-    }
-
-    // Ordered list of patterns to try (most specific to most generic)
-    QVector<QPair<QString, QString>> patterns = {
-        // 1. Explicit toolbox patterns (ubi9/toolbox, ubuntu-toolbox, etc.)
-        {"(^|/)([a-z]+)-?toolbox(:|$)", "$2"}, // ubuntu-toolbox -> ubuntu
-        {"(^|/)ubi([0-9]+)/toolbox(:|$)", "rhel"}, // ubi9/toolbox -> rhel
-        {"(^|/)([a-z]+)/toolbox(:|$)", "$2"}, // fedora/toolbox -> fedora
-
-        // 2. Versioned distro names (ubuntu:22.04, rockylinux:9)
-        {"(^|/)([a-z]+)[.:-]?([0-9]{1,2}\\.?[0-9]{0,2})(:|$)", "$2"}, // ubuntu22.04 -> ubuntu
-
-        // 3. Standard distro names in path
-        {"(^|/)(alma|alpine|amazon|arch|centos|debian|fedora|rocky|rhel|ubuntu|deepin)(:|/|$)", "$2"},
-
-        // 4. Common abbreviations and aliases
-        {"(^|/)(rh|redhat)(:|/|$)", "rhel"},
-        {"(^|/)ubi([0-9]?)(:|/|$)", "rhel"},
-        {"(^|/)nd[0-9]+(:|/|$)", "neurodebian"},
-
-        // 5. Substring fallback (least specific)
-        {"([a-z]+)(-|_)?(linux|os)", "$1"} // something-linux -> something
-    };
-
-    // Try each pattern in order
-    for (const auto &[pattern, replacement] : patterns) {
-        QRegularExpression rx(pattern);
-        QRegularExpressionMatch match = rx.match(image);
-        if (match.hasMatch()) {
-            QString matchedDistro = match.captured(replacement == "$2" ? 2 : 1);
-
-            // Validate the matched distro against our known list
-            for (const QString &distro : DISTROS) {
-                if (matchedDistro.contains(distro)) {
-                    return distro;
-                }
-            }
-        }
-    }
-
-    // Final fallback: check for any distro name as substring
-    for (const QString &distro : DISTROS) {
-        if (image.contains(distro)) {
-            return distro;
-        }
-    }
-
-    return "unknown";
+    return DistroClassifier::classify(imageUrl);
 }
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "cancellationtoken.h"
+#include <utility>
+
+CancellationToken::CancellationToken()
+    : d(std::make_shared<State>())
+{
+}
+
+void CancellationToken::cancel() const
+{
+    if (d->cancelled)
+        return;
+    d->cancelled = true;
+
+    const auto callbacks = std::exchange(d->callbacks, {});
+    for (const auto &[context, callback] : callbacks) {
+        if (context)
+            callback();
+    }
+}
+
+bool CancellationToken::isCancelled() const
+{
+    return d->cancelled;
+}
+
+void CancellationToken::onCancelled(QObject *context, const std::function<void()> &callback) const
+{
+    if (d->cancelled) {
+        callback();
+        return;
+    }
+    d->callbacks.append({QPointer<QObject>(context), callback});
+}
@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "commandrunner.h"
+#include "hostspawnserver.h"
+#include "outputsink.h"
+#include <QDebug>
+#include <QSettings>
+#include <csignal>
+#include <unistd.h>
+
+CommandJob::CommandJob(const QStringList &command, QProcess::ProcessChannelMode mode, int timeoutMs, QObject *parent)
+    : QObject(parent)
+    , m_channelMode(mode)
+{
+    m_result.command = command;
+
+    if (timeoutMs > 0) {
+        m_timeout = new QTimer(this);
+        m_timeout->setSingleShot(true);
+        m_timeout->setInterval(timeoutMs);
+        connect(m_timeout, &QTimer::timeout, this, &CommandJob::handleTimeout);
+    }
+
+    m_promise.start();
+}
+
+void CommandJob::startProcess(const QStringList &program)
+{
+    // Cancelled before the queued start got to run
+    if (m_finished)
+        return;
+
+    m_server.clear();
+    m_result.started = false;
+    m_process = new QProcess(this);
+    m_process->setProcessChannelMode(m_channelMode);
+
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &CommandJob::readStandardOutput);
+    connect(m_process, &QProcess::readyReadStandardError, this, &CommandJob::readStandardError);
+
+    // Each command leads a process group of its own so cancelling reaches every child it spawned
+    m_process->setChildProcessModifier([]() {
+        ::setsid();
+    });
+
+    connect(m_process, &QProcess::started, this, [this]() {
+        m_result.started = true;
+        m_processGroup = m_process->processId();
+        emit started();
+    });
+
+    connect(m_process, &QProcess::finished, this, [this](int exitCode, QProcess::ExitStatus exitStatus) {
+        // Children that outlived the leader of a cancelled group must not linger
+        if ((m_result.cancelled || m_result.timedOut) && m_processGroup > 0) {
+            ::kill(-static_cast<pid_t>(m_processGroup), SIGKILL);
+        }
+        m_result.exitCode = exitCode;
+        m_result.exitStatus = exitStatus;
+        finish();
+    });
+
+    // finished() is never emitted when the program could not be launched
+    connect(m_process, &QProcess::errorOccurred, this, [this, program](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            qWarning() << "Failed to start" << program.value(0) << ":" << m_process->errorString();
+            finish();
+        }
+    });
+
+    if (m_timeout && !m_timeout->isActive()) {
+        m_timeout->start();
+    }
+    m_process->start(program.first(), program.mid(1));
+}
+
+void CommandJob::startRemote(HostSpawnServer *server)
+{
+    if (m_finished)
+        return;
+
+    m_server = server;
+    if (m_timeout) {
+        m_timeout->start();
+    }
+
+    // The server may hand the job back to startProcess() if its helper cannot run
+    m_remoteId = server->submit(this);
+    if (m_remoteId != 0) {
+        m_result.started = true;
+    }
+}
+
+void CommandJob::receiveOutput(QProcess::ProcessChannel channel, const QString &text)
+{
+    if (m_finished)
+        return;
+
+    storeOutput(channel, text);
+    emit outputReceived(text);
+}
+
+void CommandJob::storeOutput(QProcess::ProcessChannel channel, const QString &text)
+{
+    if (channel == QProcess::StandardError && m_channelMode != QProcess::MergedChannels) {
+        m_result.standardError += text;
+    } else if (m_sink) {
+        m_sink->append(text);
+    } else {
+        m_result.standardOutput += text;
+    }
+}
+
+void CommandJob::receiveExit(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    m_result.exitCode = exitCode;
+    m_result.exitStatus = exitStatus;
+    finish();
+}
+
+void CommandJob::handleTimeout()
+{
+    m_result.timedOut = true;
+    terminateProcessGroup();
+}
+
+void CommandJob::cancel()
+{
+    if (m_finished || m_result.cancelled)
+        return;
+
+    m_result.cancelled = true;
+    terminateProcessGroup();
+}
+
+void CommandJob::terminateProcessGroup()
+{
+    if (m_process && m_process->state() != QProcess::NotRunning) {
+        if (m_processGroup <= 0 || ::kill(-static_cast<pid_t>(m_processGroup), SIGTERM) != 0) {
+            m_process->terminate();
+        }
+
+        QTimer::singleShot(CommandRunner::KillGracePeriod, m_process, [this]() {
+            if (m_process->state() == QProcess::NotRunning)
+                return;
+            if (m_processGroup <= 0 || ::kill(-static_cast<pid_t>(m_processGroup), SIGKILL) != 0) {
+                m_process->kill();
+            }
+        });
+        return;
+    }
+
+    // Remote commands are killed by the helper, their late output is dropped
+    if (m_server && m_remoteId != 0) {
+        m_server->cancel(m_remoteId);
+    }
+    m_result.exitStatus = QProcess::CrashExit;
+    finish();
+}
+
+QStringList CommandJob::command() const
+{
+    return m_result.command;
+}
+
+QFuture<CommandResult> CommandJob::future()
+{
+    return m_promise.future();
+}
+
+bool CommandJob::isFinished() const
+{
+    return m_finished;
+}
+
+void CommandJob::setOutputSink(OutputSink *sink)
+{
+    m_sink = sink;
+}
+
+void CommandJob::readStandardOutput()
+{
+    if (!m_process)
+        return;
+
+    const QString text = m_stdoutDecoder.decode(m_process->readAllStandardOutput());
+    if (text.isEmpty())
+        return;
+
+    storeOutput(QProcess::StandardOutput, text);
+    emit outputReceived(text);
+}
+
+void CommandJob::readStandardError()
+{
+    if (!m_process)
+        return;
+
+    const QString text = m_stderrDecoder.decode(m_process->readAllStandardError());
+    if (text.isEmpty())
+        return;
+
+    storeOutput(QProcess::StandardError, text);
+    emit outputReceived(text);
+}
+
+void CommandJob::finish()
+{
+    if (m_finished)
+        return;
+    m_finished = true;
+
+    if (m_timeout) {
+        m_timeout->stop();
+    }
+
+    // Drain whatever arrived together with the exit notification
+    readStandardOutput();
+    readStandardError();
+
+    if (m_sink) {
+        m_result.standardOutput = m_sink->tail();
+        m_result.outputTruncated = m_sink->isTruncated();
+    }
+
+    m_promise.addResult(m_result);
+    m_promise.finish();
+    emit finished(m_result);
+    deleteLater();
+}
+
+CommandRunner::CommandRunner(bool isFlatpak, QObject *parent)
+    : QObject(parent)
+    , m_isFlatpak(isFlatpak)
+{
+    qRegisterMetaType<CommandResult>();
+
+    QSettings settings;
+    if (m_isFlatpak && settings.value("flatpak/hostSpawnServer", true).toBool()) {
+        m_hostServer = new HostSpawnServer(HostSpawnServer::flatpakLauncher(), this);
+    }
+}
+
+bool CommandRunner::isFlatpak() const
+{
+    return m_isFlatpak;
+}
+
+QStringList CommandRunner::hostCommand(const QStringList &command) const
+{
+    if (m_isFlatpak) {
+        // Prepend with flatpak-spawn if running as Flatpak
+        return QStringList{"flatpak-spawn", "--host"} + command;
+    }
+    return command;
+}
+
+void CommandRunner::setHostSpawnServer(HostSpawnServer *server)
+{
+    m_hostServer = server;
+}
+
+HostSpawnServer *CommandRunner::hostSpawnServer() const
+{
+    return m_hostServer;
+}
+
+CommandJob *CommandRunner::start(const QStringList &command, QProcess::ProcessChannelMode mode, int timeoutMs, const CancellationToken &token)
+{
+    auto *job = new CommandJob(command, mode, timeoutMs, this);
+    token.onCancelled(job, [job]() {
+        // Queued as well, so a token that is already cancelled still lets the caller connect first
+        QMetaObject::invokeMethod(job, &CommandJob::cancel, Qt::QueuedConnection);
+    });
+
+    // Start from the event loop so callers can connect to the job before anything is emitted
+    if (m_hostServer && m_hostServer->isAvailable() && HostSpawnServer::canTransport(command)) {
+        QMetaObject::invokeMethod(
+            job,
+            [job, server = m_hostServer]() {
+                job->startRemote(server);
+            },
+            Qt::QueuedConnection);
+    } else {
+        const QStringList program = hostCommand(command);
+        QMetaObject::invokeMethod(
+            job,
+            [job, program]() {
+                job->startProcess(program);
+            },
+            Qt::QueuedConnection);
+    }
+    return job;
+}
+
+QFuture<CommandResult> CommandRunner::run(const QStringList &command, QProcess::ProcessChannelMode mode, int timeoutMs, const CancellationToken &token)
+{
+    return start(command, mode, timeoutMs, token)->future();
+}
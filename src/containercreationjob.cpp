@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "containercreationjob.h"
+#include <KLocalizedString>
+#include <QDebug>
+
+ContainerCreationJob::ContainerCreationJob(CommandRunner *runner, const QString &name, const QList<Step> &steps, QObject *parent)
+    : QObject(parent)
+    , m_runner(runner)
+    , m_name(name)
+    , m_steps(steps)
+    , m_output(new OutputSink(this))
+{
+}
+
+QString ContainerCreationJob::phaseName(Phase phase)
+{
+    switch (phase) {
+    case Pull:
+        return i18n("Pulling image");
+    case Create:
+        return i18n("Creating container");
+    case Init:
+        return i18n("Starting container");
+    case FirstEnter:
+        return i18n("Setting up container");
+    }
+    return QString();
+}
+
+QString ContainerCreationJob::name() const
+{
+    return m_name;
+}
+
+ContainerCreationJob::Phase ContainerCreationJob::phase() const
+{
+    return m_steps.value(qMax(0, m_current)).phase;
+}
+
+bool ContainerCreationJob::isRunning() const
+{
+    return m_running;
+}
+
+qint64 ContainerCreationJob::phaseDuration(Phase phase) const
+{
+    return m_durations.value(phase, -1);
+}
+
+OutputSink *ContainerCreationJob::output() const
+{
+    return m_output;
+}
+
+CancellationToken ContainerCreationJob::cancellationToken() const
+{
+    return m_token;
+}
+
+void ContainerCreationJob::start()
+{
+    if (m_running || m_current >= 0)
+        return;
+
+    m_running = true;
+    startStep(0);
+}
+
+void ContainerCreationJob::cancel()
+{
+    m_token.cancel();
+}
+
+void ContainerCreationJob::startStep(int index)
+{
+    if (index >= m_steps.size()) {
+        complete(true, false, i18n("Container created successfully"));
+        return;
+    }
+
+    m_current = index;
+    const Step &step = m_steps.at(index);
+    m_phaseTimer.start();
+    emit phaseStarted(step.phase);
+
+    CommandJob *job = m_runner->start(step.command, QProcess::MergedChannels, 0, m_token);
+    job->setOutputSink(m_output);
+    connect(job, &CommandJob::outputReceived, this, &ContainerCreationJob::outputReceived);
+    connect(job, &CommandJob::finished, this, &ContainerCreationJob::finishStep);
+}
+
+void ContainerCreationJob::finishStep(const CommandResult &result)
+{
+    const Phase phase = m_steps.at(m_current).phase;
+    const qint64 elapsed = m_phaseTimer.elapsed();
+    m_durations.insert(phase, elapsed);
+    qDebug() << "Container" << m_name << "phase" << phase << "took" << elapsed << "ms";
+
+    emit phaseFinished(phase, result.success(), elapsed);
+
+    if (result.cancelled) {
+        complete(false, true, i18n("Container creation cancelled"));
+        return;
+    }
+    if (!result.started) {
+        complete(false, false, i18n("Error: Failed to start %1", result.command.value(0)));
+        return;
+    }
+    if (!result.success()) {
+        const QString message = i18n("Container creation failed at \"%1\" (exit code %2)", phaseName(phase), result.exitCode);
+        complete(false, false, message + "\n\n" + m_output->tail());
+        return;
+    }
+
+    startStep(m_current + 1);
+}
+
+void ContainerCreationJob::complete(bool success, bool cancelled, const QString &message)
+{
+    m_running = false;
+    emit finished(success, cancelled, message);
+    deleteLater();
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "containereventwatcher.h"
+#include "containerlistparser.h"
+#include "outputsink.h"
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+static constexpr int MIN_RETRY_DELAY_MS = 1000;
+static constexpr int MAX_RETRY_DELAY_MS = 60000;
+
+ContainerEventWatcher::ContainerEventWatcher(CommandRunner *runner, QObject *parent)
+    : QObject(parent)
+    , m_runner(runner)
+{
+    m_reconnectTimer = new QTimer(this);
+    m_reconnectTimer->setSingleShot(true);
+    connect(m_reconnectTimer, &QTimer::timeout, this, [this]() {
+        connectStream();
+        // Whatever happened while disconnected is only visible in a full listing
+        emit resyncNeeded();
+    });
+}
+
+ContainerEventWatcher::~ContainerEventWatcher()
+{
+    m_token.cancel();
+}
+
+void ContainerEventWatcher::watch(const QString &manager, const QString &backend)
+{
+    if (m_job && manager == m_manager && backend == m_backend)
+        return;
+
+    stop();
+    m_manager = manager;
+    m_backend = backend;
+    m_retryDelay = MIN_RETRY_DELAY_MS;
+    connectStream();
+}
+
+void ContainerEventWatcher::stop()
+{
+    m_reconnectTimer->stop();
+    if (m_job) {
+        m_job->disconnect(this);
+        m_token.cancel();
+        m_job = nullptr;
+    }
+    m_streaming = false;
+    m_buffer.clear();
+}
+
+bool ContainerEventWatcher::isActive() const
+{
+    return m_streaming;
+}
+
+void ContainerEventWatcher::connectStream()
+{
+    const QString label = m_backend == "toolbox" ? QStringLiteral("label=com.github.containers.toolbox=true") : QStringLiteral("label=manager=distrobox");
+    const QString format = m_manager == "docker" ? QStringLiteral("{{json .}}") : QStringLiteral("json");
+    const QStringList command = {m_manager, "events", "--format", format, "--filter", "type=container", "--filter", label};
+
+    m_token = CancellationToken();
+    m_receivedEvent = false;
+    m_buffer.clear();
+
+    m_job = m_runner->start(command, QProcess::MergedChannels, 0, m_token);
+
+    // The stream never ends on its own, keep only a small tail of it for diagnostics
+    auto *sink = new OutputSink(4096, m_job);
+    sink->setSpillToDisk(false);
+    m_job->setOutputSink(sink);
+
+    connect(m_job, &CommandJob::started, this, [this]() {
+        m_streaming = true;
+    });
+    connect(m_job, &CommandJob::outputReceived, this, &ContainerEventWatcher::handleOutput);
+    connect(m_job, &CommandJob::finished, this, &ContainerEventWatcher::handleStreamEnded);
+}
+
+void ContainerEventWatcher::handleOutput(const QString &chunk)
+{
+    m_buffer += chunk.toUtf8();
+
+    qsizetype end;
+    while ((end = m_buffer.indexOf('\n')) >= 0) {
+        const QByteArray line = m_buffer.left(end).trimmed();
+        m_buffer.remove(0, end + 1);
+        if (!line.isEmpty())
+            handleLine(line);
+    }
+}
+
+void ContainerEventWatcher::handleLine(const QByteArray &line)
+{
+    QJsonParseError error;
+    const QJsonObject event = QJsonDocument::fromJson(line, &error).object();
+    if (error.error != QJsonParseError::NoError) {
+        qDebug() << "Ignoring non-event output from" << m_manager << "events:" << line;
+        return;
+    }
+
+    // A working stream resets the back-off
+    if (!m_receivedEvent) {
+        m_receivedEvent = true;
+        m_retryDelay = MIN_RETRY_DELAY_MS;
+    }
+
+    ContainerInfo container;
+    const QString action = ContainerListParser::parseRuntimeEvent(event, &container);
+    if (action.isEmpty())
+        return;
+
+    emit containerEvent(action, container);
+}
+
+void ContainerEventWatcher::handleStreamEnded()
+{
+    m_job = nullptr;
+    m_streaming = false;
+
+    qWarning() << m_manager << "events stream ended, reconnecting in" << m_retryDelay << "ms";
+    m_reconnectTimer->start(m_retryDelay);
+    m_retryDelay = qMin(m_retryDelay * 2, MAX_RETRY_DELAY_MS);
+}
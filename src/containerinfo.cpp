@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "containerinfo.h"
+#include <QHash>
+#include <QReadWriteLock>
+#include <deque>
+
+namespace
+{
+// Image lists are built on worker threads, so the pool is shared under a lock
+struct StringPool {
+    QReadWriteLock lock;
+    // A deque never moves its elements, ids index straight into it
+    std::deque<QString> strings{QString()};
+    QHash<QString, quint32> ids;
+};
+
+StringPool &pool()
+{
+    static StringPool pool;
+    return pool;
+}
+}
+
+InternedString::InternedString(const QString &string)
+{
+    if (string.isEmpty())
+        return;
+
+    StringPool &strings = pool();
+    {
+        QReadLocker locker(&strings.lock);
+        const auto it = strings.ids.constFind(string);
+        if (it != strings.ids.cend()) {
+            m_id = *it;
+            return;
+        }
+    }
+
+    QWriteLocker locker(&strings.lock);
+    const auto it = strings.ids.constFind(string);
+    if (it != strings.ids.cend()) {
+        m_id = *it;
+        return;
+    }
+    m_id = static_cast<quint32>(strings.strings.size());
+    strings.strings.push_back(string);
+    strings.ids.insert(string, m_id);
+}
+
+QString InternedString::toString() const
+{
+    if (m_id == 0)
+        return QString();
+
+    StringPool &strings = pool();
+    QReadLocker locker(&strings.lock);
+    return strings.strings[m_id];
+}
+
+ContainerInfo::Status ContainerInfo::statusFromString(QStringView state)
+{
+    if (state.compare(u"running", Qt::CaseInsensitive) == 0 || state.startsWith(u"up", Qt::CaseInsensitive))
+        return Status::Running;
+    if (state.compare(u"created", Qt::CaseInsensitive) == 0 || state.compare(u"configured", Qt::CaseInsensitive) == 0)
+        return Status::Created;
+    if (state.compare(u"paused", Qt::CaseInsensitive) == 0)
+        return Status::Paused;
+    if (state.compare(u"exited", Qt::CaseInsensitive) == 0 || state.compare(u"stopped", Qt::CaseInsensitive) == 0
+        || state.compare(u"dead", Qt::CaseInsensitive) == 0 || state.startsWith(u"exited", Qt::CaseInsensitive))
+        return Status::Exited;
+    return Status::Unknown;
+}
+
+QString ContainerInfo::statusName(Status status)
+{
+    switch (status) {
+    case Status::Created:
+        return QStringLiteral("created");
+    case Status::Running:
+        return QStringLiteral("running");
+    case Status::Paused:
+        return QStringLiteral("paused");
+    case Status::Exited:
+        return QStringLiteral("exited");
+    case Status::Unknown:
+        break;
+    }
+    return QString();
+}
+
+QString ContainerInfo::key() const
+{
+    // Names are unique per runtime as well
+    return id.isEmpty() ? QLatin1String("name:") + name : id;
+}
+
+bool ContainerInfo::operator==(const ContainerInfo &other) const
+{
+    return status == other.status && distro == other.distro && icon == other.icon && backend == other.backend && id == other.id && name == other.name && image == other.image
+        && imageId == other.imageId && statusText == other.statusText && created == other.created
+        && osName == other.osName;
+}
+
+QDataStream &operator<<(QDataStream &stream, const ContainerInfo &container)
+{
+    return stream << container.id << container.name << container.image << container.imageId << container.statusText << container.created
+                  << container.distro.toString() << container.icon.toString() << container.osName << container.backend.toString()
+                  << static_cast<quint8>(container.status);
+}
+
+QDataStream &operator>>(QDataStream &stream, ContainerInfo &container)
+{
+    QString distro;
+    QString icon;
+    QString backend;
+    quint8 status = 0;
+    stream >> container.id >> container.name >> container.image >> container.imageId >> container.statusText >> container.created >> distro >> icon
+        >> container.osName >> backend >> status;
+
+    container.distro = InternedString(distro);
+    container.icon = InternedString(icon);
+    container.backend = InternedString(backend);
+    container.status = status <= static_cast<quint8>(ContainerInfo::Status::Exited) ? static_cast<ContainerInfo::Status>(status) : ContainerInfo::Status::Unknown;
+    return stream;
+}
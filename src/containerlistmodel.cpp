@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "containerlistmodel.h"
+#include <QSet>
+#include <iterator>
+
+ContainerListModel::ContainerListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int ContainerListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_containers.size();
+}
+
+QVariant ContainerListModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid))
+        return QVariant();
+
+    const ContainerInfo &container = m_containers.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return container.name;
+    case Qt::ToolTipRole:
+        return container.osName.isEmpty() ? container.name : container.name + QLatin1Char('\n') + container.osName;
+    case OsNameRole:
+        return container.osName;
+    case ImageRole:
+        return container.image;
+    case DistroRole:
+        return container.distro.toString();
+    case IconRole:
+        return container.icon.toString();
+    case ReadyRole:
+        return true;
+    case PlaceholderRole:
+        return false;
+    case IdRole:
+        return container.id;
+    case StateRole:
+        return ContainerInfo::statusName(container.status);
+    case StatusRole:
+        return container.statusText;
+    case StaleRole:
+        return m_stale;
+    case BackendRole:
+        return m_showBackend ? container.backend.toString() : QString();
+    case SizeRole:
+        return m_sizes.value(container.id, {-1, -1}).first;
+    case ImageSizeRole:
+        return m_sizes.value(container.id, {-1, -1}).second;
+    case StatsRole: {
+        if (container.status != ContainerInfo::Status::Running)
+            return QVariant();
+        const auto stats = m_stats.constFind(container.id);
+        return stats == m_stats.cend() ? QVariant() : QVariant::fromValue(*stats);
+    }
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> ContainerListModel::roleNames() const
+{
+    QHash<int, QByteArray> roles = QAbstractListModel::roleNames();
+    roles.insert(ImageRole, "image");
+    roles.insert(DistroRole, "distro");
+    roles.insert(IconRole, "icon");
+    roles.insert(IdRole, "containerId");
+    roles.insert(StateRole, "state");
+    roles.insert(StatusRole, "status");
+    roles.insert(StaleRole, "stale");
+    roles.insert(StatsRole, "stats");
+    roles.insert(BackendRole, "backend");
+    roles.insert(SizeRole, "size");
+    roles.insert(ImageSizeRole, "imageSize");
+    roles.insert(OsNameRole, "osName");
+    return roles;
+}
+
+void ContainerListModel::setContainers(const ContainerList &containers)
+{
+    QSet<QString> incoming;
+    QSet<QString> ids;
+    QSet<QString> runningIds;
+    incoming.reserve(containers.size());
+    ids.reserve(containers.size());
+    for (const auto &container : containers) {
+        incoming.insert(container.key());
+        ids.insert(container.id);
+        if (container.status == ContainerInfo::Status::Running)
+            runningIds.insert(container.id);
+    }
+
+    // History of removed or stopped containers is not shown again
+    for (auto it = m_stats.begin(); it != m_stats.end();) {
+        it = runningIds.contains(it.key()) ? std::next(it) : m_stats.erase(it);
+    }
+    // Sizes stay valid while the container exists, running or not
+    for (auto it = m_sizes.begin(); it != m_sizes.end();) {
+        it = ids.contains(it.key()) ? std::next(it) : m_sizes.erase(it);
+    }
+
+    // Drop rows that are gone, merging neighbours into one removal
+    for (int row = m_containers.size() - 1; row >= 0;) {
+        if (incoming.contains(m_containers.at(row).key())) {
+            --row;
+            continue;
+        }
+
+        int first = row;
+        while (first > 0 && !incoming.contains(m_containers.at(first - 1).key())) {
+            --first;
+        }
+        beginRemoveRows(QModelIndex(), first, row);
+        m_containers.remove(first, row - first + 1);
+        endRemoveRows();
+        row = first - 1;
+    }
+
+    // Walk the new order, existing rows are moved or updated in place, new ones inserted
+    for (int row = 0; row < containers.size(); ++row) {
+        const ContainerInfo &container = containers.at(row);
+        const QString containerKey = container.key();
+
+        if (row < m_containers.size() && m_containers.at(row).key() == containerKey) {
+            if (m_containers.at(row) != container) {
+                m_containers[row] = container;
+                const QModelIndex changed = index(row);
+                emit dataChanged(changed, changed);
+            }
+            continue;
+        }
+
+        int existing = -1;
+        for (int other = row + 1; other < m_containers.size(); ++other) {
+            if (m_containers.at(other).key() == containerKey) {
+                existing = other;
+                break;
+            }
+        }
+
+        if (existing >= 0) {
+            beginMoveRows(QModelIndex(), existing, existing, QModelIndex(), row);
+            m_containers.move(existing, row);
+            endMoveRows();
+            if (m_containers.at(row) != container) {
+                m_containers[row] = container;
+                const QModelIndex changed = index(row);
+                emit dataChanged(changed, changed);
+            }
+        } else {
+            beginInsertRows(QModelIndex(), row, row);
+            m_containers.insert(row, container);
+            endInsertRows();
+        }
+    }
+}
+
+ContainerInfo ContainerListModel::container(int row) const
+{
+    return m_containers.value(row);
+}
+
+void ContainerListModel::setStats(const QString &id, const QList<ContainerStats> &history)
+{
+    if (history.isEmpty()) {
+        m_stats.remove(id);
+    } else {
+        m_stats.insert(id, history);
+    }
+
+    for (int row = 0; row < m_containers.size(); ++row) {
+        if (m_containers.at(row).id == id) {
+            const QModelIndex changed = index(row);
+            emit dataChanged(changed, changed, {StatsRole});
+            return;
+        }
+    }
+}
+
+void ContainerListModel::setSizes(const QString &id, qint64 size, qint64 imageSize)
+{
+    const std::pair<qint64, qint64> sizes(size, imageSize);
+    auto it = m_sizes.find(id);
+    if (it != m_sizes.end() && *it == sizes)
+        return;
+    m_sizes.insert(id, sizes);
+
+    for (int row = 0; row < m_containers.size(); ++row) {
+        if (m_containers.at(row).id == id) {
+            const QModelIndex changed = index(row);
+            emit dataChanged(changed, changed, {SizeRole, ImageSizeRole});
+            return;
+        }
+    }
+}
+
+void ContainerListModel::setShowBackend(bool show)
+{
+    if (m_showBackend == show)
+        return;
+
+    m_showBackend = show;
+    if (!m_containers.isEmpty())
+        emit dataChanged(index(0), index(m_containers.size() - 1), {BackendRole});
+}
+
+int ContainerListModel::rowOf(const QString &name) const
+{
+    for (int row = 0; row < m_containers.size(); ++row) {
+        if (m_containers.at(row).name == name)
+            return row;
+    }
+    return -1;
+}
+
+bool ContainerListModel::isLoading() const
+{
+    return m_loading;
+}
+
+void ContainerListModel::setLoading(bool loading)
+{
+    if (m_loading == loading)
+        return;
+
+    m_loading = loading;
+    emit loadingChanged(loading);
+}
+
+bool ContainerListModel::isStale() const
+{
+    return m_stale;
+}
+
+void ContainerListModel::setStale(bool stale)
+{
+    if (m_stale == stale)
+        return;
+
+    m_stale = stale;
+    if (!m_containers.isEmpty())
+        emit dataChanged(index(0), index(m_containers.size() - 1), {StaleRole});
+}
@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "containerlistparser.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+
+namespace
+{
+QString createdTime(const QJsonValue &created)
+{
+    // podman reports seconds since the epoch
+    if (created.isDouble()) {
+        return QDateTime::fromSecsSinceEpoch(static_cast<qint64>(created.toDouble())).toString(Qt::ISODate);
+    }
+
+    // docker: "2025-01-31 10:00:00 +0100 CET"
+    const QStringList parts = created.toString().split(' ', Qt::SkipEmptyParts);
+    if (parts.size() < 3)
+        return created.toString();
+
+    QString offset = parts[2];
+    if (offset.size() == 5)
+        offset.insert(3, ':');
+    const QDateTime time = QDateTime::fromString(parts[0] + 'T' + parts[1] + offset, Qt::ISODate);
+    return time.isValid() ? time.toString(Qt::ISODate) : created.toString();
+}
+
+ContainerInfo containerFromJson(const QJsonObject &object)
+{
+    ContainerInfo container;
+
+    // podman uses Id/ImageID/Names[], docker ID/Names as a comma separated string
+    container.id = object.value("Id").toString(object.value("ID").toString()).left(12);
+
+    const QJsonValue names = object.value("Names");
+    container.name = names.isArray() ? names.toArray().at(0).toString() : names.toString().section(',', 0, 0);
+
+    container.image = object.value("Image").toString();
+    container.imageId = object.value("ImageID").toString();
+    container.status = ContainerInfo::statusFromString(object.value("State").toString());
+    container.statusText = object.value("Status").toString();
+
+    const QJsonValue created = object.contains("Created") && object.value("Created").isDouble() ? object.value("Created") : object.value("CreatedAt");
+    container.created = createdTime(created);
+
+    return container;
+}
+}
+
+QStringList ContainerListParser::runtimeListCommand(const QString &manager, const QString &backend)
+{
+    const QString label = backend == "toolbox" ? QStringLiteral("label=com.github.containers.toolbox=true") : QStringLiteral("label=manager=distrobox");
+    return {manager, "ps", "--all", "--format", "json", "--filter", label};
+}
+
+ContainerList ContainerListParser::parseRuntimeJson(const QString &output, bool *ok)
+{
+    ContainerList containers;
+    *ok = false;
+
+    const QByteArray data = output.trimmed().toUtf8();
+    if (data.isEmpty()) {
+        // docker prints nothing at all when no container matches
+        *ok = true;
+        return containers;
+    }
+
+    QJsonParseError error;
+    if (data.startsWith('[')) {
+        const QJsonDocument document = QJsonDocument::fromJson(data, &error);
+        if (error.error != QJsonParseError::NoError || !document.isArray())
+            return {};
+
+        for (const QJsonValue &value : document.array()) {
+            containers << containerFromJson(value.toObject());
+        }
+        *ok = true;
+        return containers;
+    }
+
+    // One object per line, handled as each line arrives
+    qsizetype start = 0;
+    while (start < data.size()) {
+        qsizetype end = data.indexOf('\n', start);
+        if (end < 0)
+            end = data.size();
+
+        const QByteArray line = data.mid(start, end - start).trimmed();
+        start = end + 1;
+        if (line.isEmpty())
+            continue;
+
+        const QJsonDocument document = QJsonDocument::fromJson(line, &error);
+        if (error.error != QJsonParseError::NoError || !document.isObject())
+            return {};
+        containers << containerFromJson(document.object());
+    }
+
+    *ok = true;
+    return containers;
+}
+
+QString ContainerListParser::parseRuntimeEvent(const QJsonObject &event, ContainerInfo *container)
+{
+    // podman: {"ID", "Name", "Image", "Status"}, docker: {"Action", "Actor": {"ID", "Attributes": {"name", "image"}}}
+    const QJsonObject actor = event.value("Actor").toObject();
+    const QJsonObject attributes = actor.value("Attributes").toObject();
+
+    QString action = event.value("Status").toString(event.value("Action").toString());
+    // A kill is followed by died once the container is gone
+    if (action == "kill")
+        return QString();
+    // docker says die and destroy where podman says died and remove
+    if (action == "cleanup" || action == "exited" || action == "die")
+        action = QStringLiteral("died");
+    else if (action == "destroy")
+        action = QStringLiteral("remove");
+
+    container->id = event.value("ID").toString(actor.value("ID").toString()).left(12);
+    container->name = event.value("Name").toString(attributes.value("name").toString());
+    container->image = event.value("Image").toString(attributes.value("image").toString());
+
+    if (container->id.isEmpty() && container->name.isEmpty())
+        return QString();
+    return action;
+}
+
+ContainerList ContainerListParser::parseDistroboxTable(const QString &output)
+{
+    ContainerList containers;
+    const QStringList lines = output.split('\n', Qt::SkipEmptyParts);
+    if (lines.isEmpty())
+        return containers;
+
+    // Pipe-separated table (with header), resolve the columns once
+    QStringList headers;
+    for (const QString &col : lines[0].split('|', Qt::SkipEmptyParts)) {
+        headers << col.trimmed();
+    }
+    const qsizetype idColumn = headers.indexOf("ID");
+    const qsizetype nameColumn = headers.indexOf("NAME");
+    const qsizetype statusColumn = headers.indexOf("STATUS");
+    const qsizetype imageColumn = headers.indexOf("IMAGE");
+    if (nameColumn < 0)
+        return containers;
+
+    for (qsizetype i = 1; i < lines.size(); ++i) {
+        QStringList parts;
+        for (const QString &col : lines[i].split('|', Qt::SkipEmptyParts)) {
+            parts << col.trimmed();
+        }
+
+        if (parts.size() < headers.size())
+            continue;
+
+        ContainerInfo container;
+        container.id = parts.value(idColumn);
+        container.name = parts.value(nameColumn);
+        container.statusText = parts.value(statusColumn);
+        container.status = container.statusText.startsWith("Up") ? ContainerInfo::Status::Running : ContainerInfo::Status::Exited;
+        container.image = parts.value(imageColumn);
+
+        containers << container;
+    }
+    return containers;
+}
+
+ContainerList ContainerListParser::parseToolboxTable(const QString &output)
+{
+    static const QRegularExpression columnSeparator("\\s{2,}");
+
+    ContainerList containers;
+    const QStringList lines = output.split('\n', Qt::SkipEmptyParts);
+
+    // Toolbox format: ID NAME CREATED STATUS IMAGE
+    for (qsizetype i = 1; i < lines.size(); ++i) {
+        const QStringList parts = lines[i].trimmed().split(columnSeparator, Qt::SkipEmptyParts);
+
+        // Need at least ID, NAME, and IMAGE (some columns might be missing)
+        if (parts.size() < 3)
+            continue;
+
+        ContainerInfo container;
+        container.id = parts[0];
+        container.name = parts[1];
+        container.image = parts.last();
+        if (parts.size() >= 5) {
+            container.created = parts[2];
+            container.statusText = parts[3];
+        }
+        const QString status = container.statusText.toLower();
+        container.status = status.startsWith("up") || status == "running" ? ContainerInfo::Status::Running : ContainerInfo::Status::Exited;
+
+        containers << container;
+    }
+    return containers;
+}
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "containerosreleasecache.h"
+#include "distrotable.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace
+{
+QString cachePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/container-os-release.cache");
+}
+
+// Looks up the PIDs and prints each container's os-release after a \036<id> line.
+// /etc/os-release is usually an absolute symlink, which would resolve on the host,
+// so the file it points to is read straight from the container's root.
+const QString PROBE_SCRIPT = QStringLiteral(
+    "manager=$1; shift\n"
+    "\"$manager\" inspect --type container --format '{{.Id}} {{.State.Pid}}' \"$@\" 2>/dev/null |\n"
+    "while read -r id pid; do\n"
+    "    [ \"$pid\" -gt 0 ] 2>/dev/null || continue\n"
+    "    root=/proc/$pid/root\n"
+    "    file=$root/etc/os-release\n"
+    "    if [ -L \"$file\" ] || [ ! -e \"$file\" ]; then file=$root/usr/lib/os-release; fi\n"
+    "    printf '\\036%s\\n' \"$id\"\n"
+    "    cat \"$file\" 2>/dev/null\n"
+    "done\n");
+
+QString unquote(QString value)
+{
+    value = value.trimmed();
+    if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front())
+        value = value.mid(1, value.size() - 2);
+    return value.replace(QStringLiteral("\\\""), QStringLiteral("\"")).replace(QStringLiteral("\\\\"), QStringLiteral("\\"));
+}
+}
+
+OsRelease OsRelease::parse(const QByteArray &contents)
+{
+    OsRelease release;
+    for (const QByteArray &line : contents.split('\n')) {
+        const int equals = line.indexOf('=');
+        if (equals <= 0 || line.startsWith('#'))
+            continue;
+
+        const QByteArray key = line.left(equals).trimmed();
+        const QString value = unquote(QString::fromUtf8(line.mid(equals + 1)));
+        if (key == "ID")
+            release.id = value.toLower();
+        else if (key == "ID_LIKE")
+            release.idLike = value.toLower();
+        else if (key == "VERSION_ID")
+            release.versionId = value;
+        else if (key == "PRETTY_NAME")
+            release.prettyName = value;
+    }
+    return release;
+}
+
+ContainerOsReleaseCache::ContainerOsReleaseCache(CommandRunner *runner, QObject *parent)
+    : QObject(parent)
+    , m_runner(runner)
+{
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(2000);
+    connect(m_saveTimer, &QTimer::timeout, this, &ContainerOsReleaseCache::save);
+
+    load();
+}
+
+ContainerOsReleaseCache::~ContainerOsReleaseCache()
+{
+    if (m_saveTimer->isActive())
+        save();
+}
+
+OsRelease ContainerOsReleaseCache::osRelease(const QString &id) const
+{
+    return m_releases.value(id);
+}
+
+QString ContainerOsReleaseCache::distro(const QString &id) const
+{
+    const auto release = m_releases.constFind(id);
+    if (release == m_releases.cend())
+        return QString();
+
+    // ID is e.g. "fedora" or "opensuse-tumbleweed", derivatives name their parents in ID_LIKE
+    QString distro = DistroTable::knownDistroIn(release->id);
+    if (distro.isEmpty()) {
+        for (const QString &like : release->idLike.split(' ', Qt::SkipEmptyParts)) {
+            distro = DistroTable::knownDistroIn(like);
+            if (!distro.isEmpty())
+                break;
+        }
+    }
+    return distro;
+}
+
+QString ContainerOsReleaseCache::packageFamily(const QString &id) const
+{
+    const auto release = m_releases.constFind(id);
+    if (release == m_releases.cend())
+        return QString();
+    return DistroTable::packageFamilyName(DistroTable::packageFamily(QString(release->id + QLatin1Char(' ') + release->idLike)));
+}
+
+void ContainerOsReleaseCache::update(const ContainerList &containers, const QString &manager)
+{
+    QSet<QString> running;
+    QStringList unprobed;
+    for (const ContainerInfo &container : containers) {
+        if (container.status != ContainerInfo::Status::Running || container.id.isEmpty())
+            continue;
+        running.insert(container.id);
+        if (!m_probed.contains(container.id))
+            unprobed << container.id;
+    }
+
+    // Probed again on the next start, an upgrade may have changed the release
+    m_probed.intersect(running);
+
+    if (!unprobed.isEmpty() && !manager.isEmpty())
+        probe(unprobed, manager);
+}
+
+void ContainerOsReleaseCache::probe(const QStringList &ids, const QString &manager)
+{
+    for (const QString &id : ids) {
+        m_probed.insert(id);
+    }
+
+    m_runner->run(QStringList{"sh", "-c", PROBE_SCRIPT, "sh", manager} + ids).then(this, [this](const CommandResult &result) {
+        QStringList changed;
+        for (const QString &chunk : result.standardOutput.split(QChar(0x1e), Qt::SkipEmptyParts)) {
+            const int newline = chunk.indexOf('\n');
+            const QString id = chunk.left(newline).trimmed().left(12);
+            const OsRelease release = OsRelease::parse(newline < 0 ? QByteArray() : chunk.mid(newline + 1).toUtf8());
+            if (id.isEmpty() || !release.isValid()) {
+                qDebug() << "No os-release readable for container" << id;
+                continue;
+            }
+
+            const auto known = m_releases.constFind(id);
+            if (known != m_releases.cend() && known->id == release.id && known->idLike == release.idLike && known->versionId == release.versionId
+                && known->prettyName == release.prettyName)
+                continue;
+            m_releases.insert(id, release);
+            changed << id;
+        }
+
+        if (!changed.isEmpty()) {
+            m_saveTimer->start();
+            emit osReleaseChanged(changed);
+        }
+    });
+}
+
+void ContainerOsReleaseCache::load()
+{
+    QFile file(cachePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION)
+        return;
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString id;
+        OsRelease release;
+        stream >> id >> release.id >> release.idLike >> release.versionId >> release.prettyName;
+        m_releases.insert(id, release);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Ignoring unreadable os-release cache" << file.fileName();
+        m_releases.clear();
+    }
+}
+
+void ContainerOsReleaseCache::save()
+{
+    const QString path = cachePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not write os-release cache" << path << file.errorString();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << CACHE_MAGIC << CACHE_VERSION;
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << quint32(m_releases.size());
+    for (auto it = m_releases.cbegin(); it != m_releases.cend(); ++it) {
+        stream << it.key() << it->id << it->idLike << it->versionId << it->prettyName;
+    }
+
+    if (!file.commit())
+        qWarning() << "Could not write os-release cache" << path << file.errorString();
+}
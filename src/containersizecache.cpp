@@ -0,0 +1,309 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "containersizecache.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrent>
+
+namespace
+{
+QString cachePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/container-sizes.cache");
+}
+
+qint64 modificationTime(const QString &path)
+{
+    const QFileInfo info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+// Runs on a worker thread, symlinks are counted as links and not followed
+qint64 directorySize(const QString &path)
+{
+    qint64 total = 0;
+    QDirIterator it(path, QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo info = it.fileInfo();
+        if (info.isFile() && !info.isSymLink())
+            total += info.size();
+    }
+    return total;
+}
+}
+
+ContainerSizeCache::ContainerSizeCache(CommandRunner *runner, QObject *parent)
+    : QObject(parent)
+    , m_runner(runner)
+{
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(2000);
+    connect(m_saveTimer, &QTimer::timeout, this, &ContainerSizeCache::save);
+
+    load();
+}
+
+ContainerSizeCache::~ContainerSizeCache()
+{
+    if (m_saveTimer->isActive())
+        save();
+}
+
+qint64 ContainerSizeCache::containerSize(const QString &id) const
+{
+    return m_entries.value(id).size;
+}
+
+qint64 ContainerSizeCache::imageSize(const QString &id) const
+{
+    const auto entry = m_entries.constFind(id);
+    return entry == m_entries.cend() ? -1 : m_imageSizes.value(entry->imageId, -1);
+}
+
+bool ContainerSizeCache::isCurrent(const Entry &entry, bool running) const
+{
+    if (entry.size < 0 || entry.upperDir.isEmpty() || modificationTime(entry.upperDir) != entry.mtime)
+        return false;
+    return !running || entry.measuredAt.secsTo(QDateTime::currentDateTime()) < RUNNING_REMEASURE_SECS;
+}
+
+void ContainerSizeCache::update(const ContainerList &containers, const QString &manager)
+{
+    m_running.clear();
+
+    QStringList unknown;
+    QStringList known;
+    for (const ContainerInfo &container : containers) {
+        if (container.id.isEmpty() || m_unavailable.contains(container.id))
+            continue;
+
+        const bool running = container.status == ContainerInfo::Status::Running;
+        if (running)
+            m_running.insert(container.id);
+
+        const auto entry = m_entries.constFind(container.id);
+        if (entry == m_entries.cend() || entry->upperDir.isEmpty()) {
+            if (!m_inspecting.contains(container.id))
+                unknown << container.id;
+        } else {
+            if (!isCurrent(*entry, running))
+                queueMeasurement(container.id);
+            known << container.id;
+        }
+    }
+
+    // Sizes remembered from an earlier session show up right away
+    if (!known.isEmpty())
+        emit sizesChanged(known);
+
+    if (!unknown.isEmpty())
+        inspect(unknown, manager);
+}
+
+void ContainerSizeCache::inspect(const QStringList &ids, const QString &manager)
+{
+    for (const QString &id : ids) {
+        m_inspecting.insert(id);
+    }
+
+    // One lookup for every container not seen before
+    const QStringList command = {manager, "inspect", "--type", "container", "--format", "{{.Id}}\t{{.GraphDriver.Data.UpperDir}}\t{{.Image}}"};
+    m_runner->run(command + ids).then(this, [this, ids, manager](const CommandResult &result) {
+        QSet<QString> found;
+        QStringList images;
+        for (const QString &line : result.standardOutput.split('\n', Qt::SkipEmptyParts)) {
+            const QStringList fields = line.split('\t');
+            if (fields.size() < 3)
+                continue;
+
+            const QString id = fields[0].left(12);
+            const QString upperDir = fields[1].trimmed();
+            if (upperDir.isEmpty() || upperDir.startsWith("<no value>"))
+                continue;
+
+            Entry &entry = m_entries[id];
+            if (entry.upperDir != upperDir) {
+                entry = Entry();
+                entry.upperDir = upperDir;
+            }
+            entry.imageId = fields[2].trimmed();
+            if (!entry.imageId.isEmpty() && !m_imageSizes.contains(entry.imageId) && !images.contains(entry.imageId))
+                images << entry.imageId;
+
+            found.insert(id);
+            if (!isCurrent(entry, m_running.contains(id)))
+                queueMeasurement(id);
+        }
+
+        for (const QString &id : ids) {
+            m_inspecting.remove(id);
+            // Storage drivers without an upper directory, e.g. btrfs or vfs
+            if (!found.contains(id))
+                m_unavailable.insert(id);
+        }
+
+        if (!images.isEmpty())
+            inspectImages(images, manager);
+    });
+}
+
+void ContainerSizeCache::inspectImages(const QStringList &imageIds, const QString &manager)
+{
+    m_runner->run(QStringList{manager, "image", "inspect", "--format", "{{.Id}}\t{{.Size}}"} + imageIds).then(this, [this](const CommandResult &result) {
+        bool changed = false;
+        for (const QString &line : result.standardOutput.split('\n', Qt::SkipEmptyParts)) {
+            const QStringList fields = line.split('\t');
+            if (fields.size() < 2)
+                continue;
+
+            bool ok = false;
+            const qint64 size = fields[1].trimmed().toLongLong(&ok);
+            if (!ok)
+                continue;
+
+            // Containers refer to the image either by its bare or its sha256: prefixed ID
+            const QString id = fields[0].trimmed();
+            m_imageSizes.insert(id, size);
+            if (id.startsWith("sha256:"))
+                m_imageSizes.insert(id.mid(7), size);
+            else
+                m_imageSizes.insert(QStringLiteral("sha256:") + id, size);
+            changed = true;
+        }
+
+        if (!changed)
+            return;
+
+        QStringList ids;
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+            if (m_imageSizes.contains(it->imageId))
+                ids << it.key();
+        }
+        m_saveTimer->start();
+        emit sizesChanged(ids);
+    });
+}
+
+void ContainerSizeCache::queueMeasurement(const QString &id)
+{
+    if (!m_queue.contains(id))
+        m_queue << id;
+    measureNext();
+}
+
+void ContainerSizeCache::measureNext()
+{
+    if (m_measuring || m_queue.isEmpty())
+        return;
+
+    const QString id = m_queue.takeFirst();
+    const auto entry = m_entries.constFind(id);
+    if (entry == m_entries.cend() || entry->upperDir.isEmpty()) {
+        measureNext();
+        return;
+    }
+
+    m_measuring = true;
+    const QString upperDir = entry->upperDir;
+    const qint64 mtime = modificationTime(upperDir);
+
+    if (QFileInfo(upperDir).isReadable()) {
+        // Walking a layer can take a while, keep it off the GUI thread
+        QtConcurrent::run(directorySize, upperDir).then(this, [this, id, mtime](qint64 size) {
+            finishMeasurement(id, mtime, size);
+        });
+        return;
+    }
+
+    // Not visible from here, e.g. inside the Flatpak sandbox, let the host measure it
+    m_runner->run({"du", "-s", "-B1", upperDir}, QProcess::SeparateChannels, 0).then(this, [this, id, mtime](const CommandResult &result) {
+        bool ok = false;
+        const qint64 size = result.standardOutput.section('\t', 0, 0).trimmed().toLongLong(&ok);
+        finishMeasurement(id, mtime, ok ? size : -1);
+    });
+}
+
+void ContainerSizeCache::finishMeasurement(const QString &id, qint64 mtime, qint64 size)
+{
+    m_measuring = false;
+
+    auto entry = m_entries.find(id);
+    if (entry != m_entries.end() && size >= 0) {
+        entry->mtime = mtime;
+        entry->size = size;
+        entry->measuredAt = QDateTime::currentDateTime();
+        m_saveTimer->start();
+        emit sizesChanged({id});
+    } else if (size < 0) {
+        qDebug() << "Could not measure the writable layer of container" << id;
+        m_unavailable.insert(id);
+    }
+
+    measureNext();
+}
+
+void ContainerSizeCache::load()
+{
+    QFile file(cachePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION)
+        return;
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString id;
+        Entry entry;
+        stream >> id >> entry.upperDir >> entry.imageId >> entry.mtime >> entry.size >> entry.measuredAt;
+        // Long gone containers are forgotten eventually
+        if (entry.measuredAt.daysTo(QDateTime::currentDateTime()) <= MAX_ENTRY_AGE_DAYS)
+            m_entries.insert(id, entry);
+    }
+    stream >> m_imageSizes;
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Ignoring unreadable container size cache" << file.fileName();
+        m_entries.clear();
+        m_imageSizes.clear();
+    }
+}
+
+void ContainerSizeCache::save()
+{
+    const QString path = cachePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not write container size cache" << path << file.errorString();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << CACHE_MAGIC << CACHE_VERSION;
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << quint32(m_entries.size());
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        stream << it.key() << it->upperDir << it->imageId << it->mtime << it->size << it->measuredAt;
+    }
+    stream << m_imageSizes;
+
+    if (!file.commit())
+        qWarning() << "Could not write container size cache" << path << file.errorString();
+}
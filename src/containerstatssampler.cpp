@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "containerstatssampler.h"
+#include <QDebug>
+#include <QFile>
+#include <QSettings>
+#include <algorithm>
+
+namespace
+{
+const QString CGROUP_ROOT = QStringLiteral("/sys/fs/cgroup");
+
+QByteArray readSmallFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+// "key value" lines as found in cpu.stat
+qint64 statValue(const QByteArray &stat, const QByteArray &key)
+{
+    for (const QByteArray &line : stat.split('\n')) {
+        if (line.startsWith(key) && line.size() > key.size() && line.at(key.size()) == ' ')
+            return line.mid(key.size() + 1).trimmed().toLongLong();
+    }
+    return -1;
+}
+}
+
+ContainerStatsSampler::ContainerStatsSampler(CommandRunner *runner, QObject *parent)
+    : QObject(parent)
+    , m_runner(runner)
+{
+    qRegisterMetaType<ContainerStats>();
+    qRegisterMetaType<QList<ContainerStats>>();
+
+    QSettings settings;
+    m_interval = qMax(0, settings.value("stats/sampleInterval", 2000).toInt());
+
+    m_timer = new QTimer(this);
+    m_timer->setTimerType(Qt::CoarseTimer);
+    connect(m_timer, &QTimer::timeout, this, &ContainerStatsSampler::sample);
+}
+
+int ContainerStatsSampler::interval() const
+{
+    return m_interval;
+}
+
+void ContainerStatsSampler::setInterval(int interval)
+{
+    interval = qMax(0, interval);
+    if (interval == m_interval)
+        return;
+
+    m_interval = interval;
+    QSettings settings;
+    settings.setValue("stats/sampleInterval", m_interval);
+    updateTimer();
+}
+
+bool ContainerStatsSampler::isPaused() const
+{
+    return m_paused;
+}
+
+void ContainerStatsSampler::setPaused(bool paused)
+{
+    if (paused == m_paused)
+        return;
+
+    m_paused = paused;
+    if (!paused) {
+        // Rates over the paused period say nothing, start counting again
+        for (Sampled &container : m_containers) {
+            container.counters = Counters();
+        }
+    }
+    updateTimer();
+}
+
+void ContainerStatsSampler::setContainers(const ContainerList &containers, const QString &manager)
+{
+    if (manager != m_manager) {
+        m_containers.clear();
+        m_unavailable.clear();
+        m_manager = manager;
+    }
+
+    QSet<QString> running;
+    for (const ContainerInfo &container : containers) {
+        if (container.status == ContainerInfo::Status::Running && !container.id.isEmpty())
+            running.insert(container.id);
+    }
+
+    for (auto it = m_containers.begin(); it != m_containers.end();) {
+        if (running.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_containers.erase(it);
+        }
+    }
+    // A restarted container may well have a cgroup now
+    m_unavailable.intersect(running);
+
+    QStringList unresolved;
+    for (const QString &id : std::as_const(running)) {
+        if (!m_containers.contains(id) && !m_unavailable.contains(id)) {
+            m_containers.insert(id, Sampled());
+            unresolved << id;
+        }
+    }
+
+    if (!unresolved.isEmpty() && !m_manager.isEmpty())
+        resolveCgroups(unresolved);
+    updateTimer();
+}
+
+QList<ContainerStats> ContainerStatsSampler::history(const QString &id) const
+{
+    const auto it = m_containers.constFind(id);
+    return it == m_containers.cend() ? QList<ContainerStats>() : it->history;
+}
+
+void ContainerStatsSampler::resolveCgroups(const QStringList &ids)
+{
+    // One inspect for all containers that started since the last list
+    const QString format = m_manager == "docker" ? QStringLiteral("{{.Id}} {{.State.Pid}}") : QStringLiteral("{{.Id}} {{.State.Pid}} {{.State.CgroupPath}}");
+    const QString manager = m_manager;
+    m_runner->run(QStringList{m_manager, "inspect", "--type", "container", "--format", format} + ids).then(this, [this, ids, manager](const CommandResult &result) {
+        if (manager != m_manager)
+            return;
+
+        QHash<QString, QString> cgroups;
+        for (const QString &line : result.standardOutput.split('\n', Qt::SkipEmptyParts)) {
+            const QStringList fields = line.split(' ', Qt::SkipEmptyParts);
+            if (fields.size() < 2)
+                continue;
+
+            QString path = fields.value(2);
+            if (path.isEmpty()) {
+                // No cgroup in the inspect output, ask the kernel about the container's main process
+                const QByteArray processCgroups = readSmallFile(QStringLiteral("/proc/%1/cgroup").arg(fields[1]));
+                for (const QByteArray &entry : processCgroups.split('\n')) {
+                    if (entry.startsWith("0::"))
+                        path = QString::fromUtf8(entry.mid(3));
+                }
+            }
+            if (!path.isEmpty())
+                cgroups.insert(fields[0].left(12), CGROUP_ROOT + path);
+        }
+
+        for (const QString &id : ids) {
+            auto it = m_containers.find(id);
+            if (it == m_containers.end())
+                continue;
+
+            const QString cgroup = cgroups.value(id);
+            if (cgroup.isEmpty() || !QFile::exists(cgroup + QStringLiteral("/memory.current"))) {
+                qDebug() << "No cgroup v2 statistics available for container" << id;
+                m_unavailable.insert(id);
+                m_containers.erase(it);
+                continue;
+            }
+            it->cgroup = cgroup;
+        }
+        updateTimer();
+    });
+}
+
+void ContainerStatsSampler::updateTimer()
+{
+    bool sampling = m_interval > 0 && !m_paused;
+    if (sampling) {
+        sampling = std::any_of(m_containers.cbegin(), m_containers.cend(), [](const Sampled &container) {
+            return !container.cgroup.isEmpty();
+        });
+    }
+
+    if (!sampling) {
+        m_timer->stop();
+    } else if (!m_timer->isActive() || m_timer->interval() != m_interval) {
+        m_timer->start(m_interval);
+        // Prime the counters so the first tick already yields rates
+        sample();
+    }
+}
+
+void ContainerStatsSampler::sample()
+{
+    QStringList updated;
+    for (auto it = m_containers.begin(); it != m_containers.end(); ++it) {
+        if (it->cgroup.isEmpty())
+            continue;
+
+        ContainerStats stats;
+        if (!readSample(*it, &stats))
+            continue;
+
+        it->history.append(stats);
+        if (it->history.size() > HISTORY_SIZE)
+            it->history.removeFirst();
+        updated << it.key();
+    }
+
+    if (!updated.isEmpty())
+        emit statsUpdated(updated);
+}
+
+bool ContainerStatsSampler::readSample(Sampled &container, ContainerStats *stats)
+{
+    const QByteArray memory = readSmallFile(container.cgroup + QStringLiteral("/memory.current"));
+    const qint64 cpuUsage = statValue(readSmallFile(container.cgroup + QStringLiteral("/cpu.stat")), "usage_usec");
+    // The container stopped, the next list update drops it
+    if (memory.isEmpty() || cpuUsage < 0)
+        return false;
+
+    // "<major>:<minor> rbytes=... wbytes=... rios=..." per device, io may not be delegated at all
+    Counters counters;
+    counters.cpuUsageUsec = cpuUsage;
+    for (const QByteArray &line : readSmallFile(container.cgroup + QStringLiteral("/io.stat")).split('\n')) {
+        for (const QByteArray &field : line.split(' ')) {
+            if (field.startsWith("rbytes="))
+                counters.readBytes += field.mid(7).toLongLong();
+            else if (field.startsWith("wbytes="))
+                counters.writeBytes += field.mid(7).toLongLong();
+        }
+    }
+
+    const Counters previous = container.counters;
+    const qint64 elapsedMs = container.sinceLast.isValid() ? container.sinceLast.restart() : 0;
+    if (!container.sinceLast.isValid())
+        container.sinceLast.start();
+    container.counters = counters;
+
+    // The first read only establishes the baseline
+    if (previous.cpuUsageUsec < 0 || elapsedMs <= 0)
+        return false;
+
+    stats->memoryBytes = memory.trimmed().toLongLong();
+    stats->cpuPercent = qMax<qint64>(0, counters.cpuUsageUsec - previous.cpuUsageUsec) / (elapsedMs * 10.0);
+    stats->readBytesPerSecond = qMax<qint64>(0, counters.readBytes - previous.readBytes) * 1000 / elapsedMs;
+    stats->writeBytesPerSecond = qMax<qint64>(0, counters.writeBytes - previous.writeBytes) * 1000 / elapsedMs;
+    return true;
+}
@@ -3,6 +3,8 @@
 
 #include "createcontainerdialog.h"
 #include "backend.h"
+#include <QtConcurrent/QtConcurrent>
+#include <memory>
 
 // Custom item delegate for image list
 class ImageListItemDelegate : public QStyledItemDelegate
@@ -74,7 +76,6 @@ CreateContainerDialog::CreateContainerDialog(Backend *backend, QWidget *parent)
     : QDialog(parent)
     , m_backend(backend)
     , m_progressDialog(nullptr)
-    , m_createProcess(nullptr)
 {
     // Window setup
     setWindowTitle(i18n("Create New Container"));
@@ -104,7 +105,12 @@ CreateContainerDialog::CreateContainerDialog(Backend *backend, QWidget *parent)
     m_searchEdit->setPlaceholderText(i18n("Search images..."));
     m_searchEdit->setClearButtonEnabled(true);
     m_searchEdit->setStyleSheet("QLineEdit { padding: 3px; }");
-    connect(m_searchEdit, &QLineEdit::textChanged, this, &CreateContainerDialog::searchImages);
+    // A burst of keystrokes ends up in one search
+    m_searchTimer = new QTimer(this);
+    m_searchTimer->setSingleShot(true);
+    m_searchTimer->setInterval(60);
+    connect(m_searchTimer, &QTimer::timeout, this, &CreateContainerDialog::searchImages);
+    connect(m_searchEdit, &QLineEdit::textChanged, m_searchTimer, qOverload<>(&QTimer::start));
 
     // Add search edit to search layout
     searchLayout->addWidget(m_searchEdit);
@@ -153,7 +159,7 @@ CreateContainerDialog::CreateContainerDialog(Backend *backend, QWidget *parent)
     if (backend->preferredBackend() != "toolbox") {
         QPushButton *refreshButton = new QPushButton(i18n("Refresh Images"), this);
         refreshButton->setIcon(QIcon::fromTheme("view-refresh"));
-        connect(refreshButton, &QPushButton::clicked, this, &CreateContainerDialog::refreshImages);
+        connect(refreshButton, &QPushButton::clicked, this, &CreateContainerDialog::reloadImages);
         buttonLayout->addWidget(refreshButton);
     }
 
@@ -179,59 +185,81 @@ CreateContainerDialog::CreateContainerDialog(Backend *backend, QWidget *parent)
     mainLayout->addLayout(buttonLayout);
 
     // Initial images load
-    refreshImages();
+    showAvailableImages(false);
 }
 
 CreateContainerDialog::~CreateContainerDialog()
 {
-    if (m_createProcess) {
-        if (m_createProcess->state() == QProcess::Running) {
-            m_createProcess->terminate();
-            m_createProcess->waitForFinished(1000);
-        }
-        delete m_createProcess;
-    }
     delete m_progressDialog;
 }
 
-void CreateContainerDialog::refreshImages()
+void CreateContainerDialog::reloadImages()
 {
-    m_imageList->clear();
-    QList<QMap<QString, QString>> images = m_backend->getAvailableImages();
-
-    for (const auto &image : images) {
-        QString displayText = image.value("display", image["url"]);
-        QString distro = image["distro"];
-        QString iconPath = image["icon"];
+    // The button asks for a fresh listing, not the cached one
+    showAvailableImages(true);
+}
 
-        QListWidgetItem *item = new QListWidgetItem(displayText, m_imageList);
-        item->setData(Qt::UserRole, image["url"]); // Store URL in UserRole
-        item->setData(Qt::UserRole + 1, distro); // Store distro in UserRole + 1
-        item->setData(Qt::UserRole + 2, iconPath); // Store icon path in UserRole + 2
-        item->setToolTip(image["url"]);
-    }
+void CreateContainerDialog::showAvailableImages(bool reload)
+{
+    // Only the most recent request may fill the list
+    const int request = ++m_imageRequest;
+
+    m_backend->getAvailableImages(reload)
+        .then(this,
+              [](const ImageList &images) {
+                  return QtConcurrent::run([images]() {
+                      return std::make_shared<const ImageSearchIndex>(images);
+                  });
+              })
+        .unwrap()
+        .then(this, [this, request](const std::shared_ptr<const ImageSearchIndex> &index) {
+            if (request != m_imageRequest)
+                return;
+
+            m_searchIndex = index;
+            m_lastQuery.clear();
+            m_lastResult.clear();
+            searchImages();
+        });
 }
 
-void CreateContainerDialog::searchImages(const QString &query)
+void CreateContainerDialog::searchImages()
 {
-    if (query.isEmpty()) {
-        refreshImages();
+    // Until the index is built there is nothing to search, it runs the query itself
+    if (!m_searchIndex)
         return;
-    }
 
+    const int request = ++m_searchRequest;
+    const QString query = m_searchEdit->text().trimmed().toLower();
+    const bool narrows = !m_lastQuery.isEmpty() && query.startsWith(m_lastQuery);
+    const QList<int> previous = narrows ? m_lastResult : QList<int>();
+
+    QtConcurrent::run([index = m_searchIndex, query, previous, narrows]() {
+        return index->search(query, narrows ? &previous : nullptr);
+    }).then(this, [this, request, query](const QList<int> &rows) {
+        if (request != m_searchRequest)
+            return;
+
+        m_lastQuery = query;
+        m_lastResult = rows;
+        showImages(rows);
+    });
+}
+
+void CreateContainerDialog::showImages(const QList<int> &rows)
+{
     m_imageList->clear();
-    QList<QMap<QString, QString>> images = m_backend->searchImages(query);
-
-    for (const auto &image : images) {
-        QString url = image["url"];
-        QString distro = image["distro"];
-        QString iconPath = image["icon"];
-
-        QListWidgetItem *item = new QListWidgetItem(url, m_imageList);
-        item->setData(Qt::UserRole, url); // Store URL in UserRole
-        item->setData(Qt::UserRole + 1, distro); // Store distro in UserRole + 1
-        item->setData(Qt::UserRole + 2, iconPath); // Store icon path in UserRole + 2
-        item->setToolTip(url);
+    for (const int row : rows) {
+        const ImageInfo &image = m_searchIndex->image(row);
+        QString displayText = image.display.isEmpty() ? image.url : image.display;
+        if (image.local)
+            displayText = i18nc("@item image already in local storage", "%1 (downloaded)", displayText);
+
+        QListWidgetItem *item = new QListWidgetItem(displayText, m_imageList);
+        item->setData(Qt::UserRole, image.url); // Store URL in UserRole
+        item->setData(Qt::UserRole + 1, image.distro.toString()); // Store distro in UserRole + 1
+        item->setData(Qt::UserRole + 2, image.icon.toString()); // Store icon path in UserRole + 2
+        item->setToolTip(image.local ? i18n("%1\nAlready downloaded, no pull needed", image.url) : image.url);
     }
 }
 
@@ -254,6 +282,12 @@ void CreateContainerDialog::startContainerCreation()
         return;
     }
 
+    ContainerCreationJob *job = m_backend->createContainer(name, image, home, init, volumes);
+    if (!job) {
+        QMessageBox::critical(this, i18n("Error"), i18n("Error: No supported backend available"));
+        return;
+    }
+
     // Setup progress dialog
     if (m_progressDialog) {
         m_progressDialog->deleteLater();
@@ -261,28 +295,48 @@ void CreateContainerDialog::startContainerCreation()
     m_progressDialog = new QProgressDialog(this);
     m_progressDialog->setWindowTitle(i18n("Creating Container"));
     m_progressDialog->setLabelText(i18n("Starting container creation..."));
-    m_progressDialog->setRange(0, 0);
-    m_progressDialog->setCancelButton(nullptr);
+    m_progressDialog->setRange(0, 4);
+    m_progressDialog->setAutoClose(false);
+    m_progressDialog->setAutoReset(false);
+    m_progressDialog->setCancelButtonText(i18n("Cancel"));
     m_progressDialog->show();
 
-    // Disconnect any existing connections
-    disconnect(m_backend, &Backend::containerOutput, this, nullptr);
-    disconnect(m_backend, &Backend::containerCreationFinished, this, nullptr);
+    // Cancelling stops the current phase and removes whatever was already created
+    connect(m_progressDialog, &QProgressDialog::canceled, job, &ContainerCreationJob::cancel);
 
-    // Connect signals
-    connect(m_backend, &Backend::containerOutput, this, [this](const QString &output) {
-        if (m_progressDialog) {
-            m_progressDialog->setLabelText(output);
+    // Everything below is tied to this job, so concurrent creations never see each other's signals
+    auto phaseLabel = std::make_shared<QString>();
+    connect(job, &ContainerCreationJob::phaseStarted, this, [this, phaseLabel](ContainerCreationJob::Phase phase) {
+        *phaseLabel = ContainerCreationJob::phaseName(phase) + QStringLiteral("...");
+        if (m_progressDialog)
+            m_progressDialog->setLabelText(*phaseLabel);
+    });
+    connect(job, &ContainerCreationJob::phaseFinished, this, [this](ContainerCreationJob::Phase phase, bool success) {
+        if (m_progressDialog && success)
+            m_progressDialog->setValue(static_cast<int>(phase) + 1);
+    });
+    connect(job, &ContainerCreationJob::outputReceived, this, [this, phaseLabel](const QString &output) {
+        if (!m_progressDialog)
+            return;
+
+        const QString line = output.trimmed().section('\n', -1).section('\r', -1).trimmed();
+        if (!line.isEmpty()) {
+            m_progressDialog->setLabelText(*phaseLabel + '\n' + fontMetrics().elidedText(line, Qt::ElideRight, 500));
         }
     });
 
-    connect(m_backend, &Backend::containerCreationFinished, this, [this, name](bool success, const QString &message) {
+    connect(job, &ContainerCreationJob::finished, this, [this, name](bool success, bool cancelled, const QString &message) {
         if (m_progressDialog) {
+            m_progressDialog->disconnect();
             m_progressDialog->cancel();
             m_progressDialog->deleteLater();
             m_progressDialog = nullptr;
         }
 
+        // Back to the form, the user asked for this
+        if (cancelled)
+            return;
+
         if (success) {
             QString successMsg = i18n(
                 "Container '%1' created successfully!\n\n"
@@ -299,71 +353,7 @@ void CreateContainerDialog::startContainerCreation()
         }
     });
 
-    // Start container creation
-    m_backend->createContainer(name, image, home, init, volumes);
-}
-
-void CreateContainerDialog::handleReadyRead()
-{
-    QString output = QString::fromUtf8(m_createProcess->readAll());
-    if (!output.isEmpty()) {
-        m_progressDialog->setLabelText(output);
-        qDebug() << i18n("Process output:") << output;
-    }
-}
-
-void CreateContainerDialog::handleErrorOccurred(QProcess::ProcessError error)
-{
-    m_progressDialog->cancel();
-    QString errorMsg = i18n("Process error:") + QLatin1String(" ");
-    switch (error) {
-    case QProcess::FailedToStart:
-        errorMsg += i18n("Failed to start");
-        break;
-    case QProcess::Crashed:
-        errorMsg += i18n("Crashed");
-        break;
-    case QProcess::Timedout:
-        errorMsg += i18n("Timed out");
-        break;
-    case QProcess::WriteError:
-        errorMsg += i18n("Write error");
-        break;
-    case QProcess::ReadError:
-        errorMsg += i18n("Read error");
-        break;
-    default:
-        errorMsg += i18n("Unknown error");
-        break;
-    }
-    errorMsg += "\n" + m_createProcess->errorString();
-
-    QMessageBox::critical(this, i18n("Error"), errorMsg);
-    m_createProcess->deleteLater();
-    m_createProcess = nullptr;
-}
-
-void CreateContainerDialog::handleCreateFinished(int exitCode, QProcess::ExitStatus exitStatus)
-{
-    m_progressDialog->cancel();
-
-    if (exitStatus == QProcess::NormalExit && exitCode == 0) {
-        QString successMsg = i18n("Container “%1” created successfully!", containerName());
-        m_progressDialog->setLabelText(successMsg);
-        QMessageBox::information(this, i18n("Success"), successMsg);
-        m_backend->enterContainer(containerName());
-        accept();
-    } else {
-        QString errorOutput = QString::fromUtf8(m_createProcess->readAll());
-        QString errorMsg = i18n("Container creation failed (exit code: %1)", exitCode);
-        if (!errorOutput.isEmpty()) {
-            errorMsg = i18n("Container creation failed (exit code: %1)\n\nError output: %2\n", exitCode, errorOutput);
-        }
-        QMessageBox::critical(this, i18n("Error"), errorMsg);
-    }
-
-    m_createProcess->deleteLater();
-    m_createProcess = nullptr;
+    job->start();
 }
 
 QString CreateContainerDialog::containerName() const
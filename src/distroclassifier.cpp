@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "distroclassifier.h"
+#include "distrotable.h"
+#include <QCache>
+#include <QList>
+#include <QMutex>
+#include <QRegularExpression>
+#include <array>
+#include <utility>
+
+namespace
+{
+// Enough for every image of the catalog plus the local containers
+constexpr int MEMO_SIZE = 1024;
+
+struct Rule {
+    QRegularExpression pattern;
+    // Capture group holding the candidate name
+    int group;
+};
+
+const QList<Rule> &rules()
+{
+    // Ordered from most specific to most generic
+    static const QList<Rule> compiled = [] {
+        const std::array<std::pair<const char *, int>, 9> patterns = {{
+            // 1. Explicit toolbox patterns (ubi9/toolbox, ubuntu-toolbox, etc.)
+            {"(^|/)([a-z]+)-?toolbox(:|$)", 2}, // ubuntu-toolbox -> ubuntu
+            {"(^|/)ubi([0-9]+)/toolbox(:|$)", 1}, // ubi9/toolbox -> rhel
+            {"(^|/)([a-z]+)/toolbox(:|$)", 2}, // fedora/toolbox -> fedora
+
+            // 2. Versioned distro names (ubuntu:22.04, rockylinux:9)
+            {"(^|/)([a-z]+)[.:-]?([0-9]{1,2}\\.?[0-9]{0,2})(:|$)", 2}, // ubuntu22.04 -> ubuntu
+
+            // 3. Standard distro names in path
+            {"(^|/)(alma|alpine|amazon|arch|centos|debian|fedora|rocky|rhel|ubuntu|deepin)(:|/|$)", 2},
+
+            // 4. Common abbreviations and aliases
+            {"(^|/)(rh|redhat)(:|/|$)", 1},
+            {"(^|/)ubi([0-9]?)(:|/|$)", 1},
+            {"(^|/)nd[0-9]+(:|/|$)", 1},
+
+            // 5. Substring fallback (least specific)
+            {"([a-z]+)(-|_)?(linux|os)", 1} // something-linux -> something
+        }};
+
+        QList<Rule> result;
+        result.reserve(patterns.size());
+        for (const auto &[pattern, group] : patterns) {
+            Rule rule{QRegularExpression(QString::fromLatin1(pattern)), group};
+            // Compile (and JIT) now instead of on the first match
+            rule.pattern.optimize();
+            result << rule;
+        }
+        return result;
+    }();
+    return compiled;
+}
+
+QString classifyUncached(const QString &imageUrl)
+{
+    const QString image = imageUrl.toLower();
+
+    // First check hardcoded URL mappings (prefix matches)
+    static const std::array<std::pair<QLatin1String, QLatin1String>, 3> hardcodedMappings = {{
+        {QLatin1String("ghcr.io/vanilla-os/vso:main"), QLatin1String("vso")},
+        {QLatin1String("docker.io/blackarchlinux/blackarch:latest"), QLatin1String("blackarch")},
+        {QLatin1String("cgr.dev/chainguard/wolfi-base"), QLatin1String("wolfi")},
+    }};
+    for (const auto &[prefix, distro] : hardcodedMappings) {
+        if (image.startsWith(prefix))
+            return distro;
+    }
+
+    for (const Rule &rule : rules()) {
+        const QRegularExpressionMatch match = rule.pattern.match(image);
+        if (!match.hasMatch())
+            continue;
+
+        // Validate the matched distro against our known list
+        const QString distro = DistroTable::knownDistroIn(match.capturedView(rule.group));
+        if (!distro.isEmpty())
+            return distro;
+    }
+
+    // Final fallback: check for any distro name as substring
+    const QString distro = DistroTable::knownDistroIn(image);
+    return distro.isEmpty() ? QStringLiteral("unknown") : distro;
+}
+}
+
+namespace DistroClassifier
+{
+QString classify(const QString &imageUrl)
+{
+    // Image lists are classified on worker threads
+    static QMutex mutex;
+    static QCache<QString, QString> memo(MEMO_SIZE);
+
+    {
+        QMutexLocker locker(&mutex);
+        if (const QString *distro = memo.object(imageUrl))
+            return *distro;
+    }
+
+    const QString distro = classifyUncached(imageUrl);
+
+    QMutexLocker locker(&mutex);
+    memo.insert(imageUrl, new QString(distro));
+    return distro;
+}
+}
@@ -0,0 +1,293 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "distrotable.h"
+#include <QtAlgorithms>
+#include <array>
+#include <iterator>
+
+using namespace DistroTable;
+
+namespace
+{
+constexpr std::size_t DISTRO_COUNT = std::size(DISTROS);
+constexpr std::size_t TOOLBOX_IMAGE_COUNT = std::size(TOOLBOX_IMAGES);
+constexpr quint8 NO_ENTRY = 0xff;
+
+constexpr char16_t foldCase(char16_t c)
+{
+    return c >= u'A' && c <= u'Z' ? c + (u'a' - u'A') : c;
+}
+
+// FNV-1a keeps its low bits weak, fold the high ones in before taking a slot
+constexpr quint32 finish(quint32 h)
+{
+    h ^= h >> 16;
+    h *= 0x45d9f3bu;
+    return h ^ (h >> 16);
+}
+
+// FNV-1a over the case folded UTF-16 code units, the same for keys and lookups
+template<typename String>
+constexpr quint32 hash(const String &string, quint32 seed)
+{
+    quint32 h = 2166136261u ^ seed;
+    for (std::size_t i = 0; i < std::size_t(string.size()); ++i) {
+        h ^= foldCase(static_cast<char16_t>(static_cast<unsigned char>(string[i])));
+        h *= 16777619u;
+    }
+    return finish(h);
+}
+
+quint32 hash(QStringView string, quint32 seed)
+{
+    quint32 h = 2166136261u ^ seed;
+    for (const QChar c : string) {
+        h ^= foldCase(c.unicode());
+        h *= 16777619u;
+    }
+    return finish(h);
+}
+
+// Collision free, not minimal: the slot array is sparse enough that a seed is found after a few tries
+template<std::size_t Slots>
+struct PerfectHash {
+    quint32 seed = 0;
+    std::array<quint8, Slots> slots{};
+
+    int index(QStringView key) const
+    {
+        const quint8 slot = slots[hash(key, seed) % Slots];
+        return slot == NO_ENTRY ? -1 : slot;
+    }
+};
+
+template<std::size_t Slots, typename Entries, typename Key>
+constexpr PerfectHash<Slots> buildPerfectHash(const Entries &entries, Key key)
+{
+    for (quint32 seed = 0;; ++seed) {
+        PerfectHash<Slots> table;
+        table.seed = seed;
+        for (std::size_t slot = 0; slot < Slots; ++slot) {
+            table.slots[slot] = NO_ENTRY;
+        }
+
+        bool collision = false;
+        for (std::size_t i = 0; i < std::size(entries) && !collision; ++i) {
+            quint8 &slot = table.slots[hash(key(entries[i]), seed) % Slots];
+            collision = slot != NO_ENTRY;
+            slot = static_cast<quint8>(i);
+        }
+        if (!collision)
+            return table;
+    }
+}
+
+constexpr PerfectHash<256> DISTRO_HASH = buildPerfectHash<256>(DISTROS, [](const Distro &distro) {
+    return distro.name;
+});
+constexpr PerfectHash<512> TOOLBOX_IMAGE_HASH = buildPerfectHash<512>(TOOLBOX_IMAGES, [](const ToolboxImage &image) {
+    return image.image;
+});
+
+// Aho-Corasick over the distro names, flattened into a DFA on a-z. Every
+// state carries the set of names (bit i for DISTROS[i]) that end there, so
+// one pass over an image reference yields every name it contains.
+constexpr std::size_t ALPHABET = 26;
+
+constexpr std::size_t stateCount()
+{
+    std::size_t states = 1;
+    for (const Distro &distro : DISTROS) {
+        states += distro.name.size();
+    }
+    return states;
+}
+
+struct Automaton {
+    std::array<std::array<quint16, ALPHABET>, stateCount()> next{};
+    std::array<quint64, stateCount()> matches{};
+};
+
+constexpr Automaton buildAutomaton()
+{
+    Automaton automaton;
+
+    // The trie, state 0 is the root and no state points back to it yet
+    std::size_t states = 1;
+    for (std::size_t i = 0; i < DISTRO_COUNT; ++i) {
+        std::size_t state = 0;
+        for (const char c : DISTROS[i].name) {
+            quint16 &next = automaton.next[state][c - 'a'];
+            if (next == 0)
+                next = static_cast<quint16>(states++);
+            state = next;
+        }
+        automaton.matches[state] |= quint64(1) << i;
+    }
+
+    // Breadth first, so a state's fallback is complete before the state itself
+    std::array<quint16, stateCount()> fallback{};
+    std::array<quint16, stateCount()> queue{};
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    for (std::size_t c = 0; c < ALPHABET; ++c) {
+        if (automaton.next[0][c] != 0)
+            queue[tail++] = automaton.next[0][c];
+    }
+    while (head < tail) {
+        const quint16 state = queue[head++];
+        automaton.matches[state] |= automaton.matches[fallback[state]];
+        for (std::size_t c = 0; c < ALPHABET; ++c) {
+            quint16 &next = automaton.next[state][c];
+            if (next != 0) {
+                fallback[next] = automaton.next[fallback[state]][c];
+                queue[tail++] = next;
+            } else {
+                next = automaton.next[fallback[state]][c];
+            }
+        }
+    }
+    return automaton;
+}
+
+constexpr Automaton AUTOMATON = buildAutomaton();
+
+template<typename Predicate>
+constexpr quint64 maskOf(Predicate predicate)
+{
+    quint64 mask = 0;
+    for (std::size_t i = 0; i < DISTRO_COUNT; ++i) {
+        if (predicate(DISTROS[i]))
+            mask |= quint64(1) << i;
+    }
+    return mask;
+}
+
+constexpr quint64 KNOWN_MASK = maskOf([](const Distro &distro) {
+    return distro.known;
+});
+constexpr quint64 ICON_MASK = maskOf([](const Distro &distro) {
+    return !distro.icon.empty();
+});
+
+constexpr bool isValidTable()
+{
+    for (std::size_t i = 0; i < DISTRO_COUNT; ++i) {
+        if (DISTROS[i].name.empty() || (i > 0 && !(DISTROS[i - 1].name < DISTROS[i].name)))
+            return false;
+        for (const char c : DISTROS[i].name) {
+            if (c < 'a' || c > 'z')
+                return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool toolboxDistrosAreListed()
+{
+    for (const ToolboxImage &image : TOOLBOX_IMAGES) {
+        bool listed = false;
+        for (const Distro &distro : DISTROS) {
+            listed = listed || distro.name == image.distro;
+        }
+        if (!listed)
+            return false;
+    }
+    return true;
+}
+
+static_assert(DISTRO_COUNT <= 64, "name sets are kept in a 64 bit mask");
+static_assert(DISTRO_COUNT < NO_ENTRY && TOOLBOX_IMAGE_COUNT < NO_ENTRY, "perfect hash slots store indices in a byte");
+static_assert(isValidTable(), "DISTROS must be sorted, unique and lower case a-z");
+static_assert(toolboxDistrosAreListed(), "every toolbox image needs its distro in DISTROS");
+
+// Names contained in text, as a mask over DISTROS
+quint64 namesIn(QStringView text)
+{
+    quint64 found = 0;
+    quint16 state = 0;
+    for (const QChar ch : text) {
+        const char16_t c = foldCase(ch.unicode());
+        if (c < u'a' || c > u'z') {
+            state = 0;
+            continue;
+        }
+        state = AUTOMATON.next[state][c - u'a'];
+        found |= AUTOMATON.matches[state];
+    }
+    return found;
+}
+
+const Distro *firstOf(quint64 mask)
+{
+    return mask == 0 ? nullptr : &DISTROS[qCountTrailingZeroBits(mask)];
+}
+}
+
+namespace DistroTable
+{
+const Distro *find(QStringView name)
+{
+    const int index = DISTRO_HASH.index(name);
+    if (index < 0 || name.compare(QLatin1String(DISTROS[index].name.data(), qsizetype(DISTROS[index].name.size())), Qt::CaseInsensitive) != 0)
+        return nullptr;
+    return &DISTROS[index];
+}
+
+QString knownDistroIn(QStringView text)
+{
+    const Distro *distro = firstOf(namesIn(text) & KNOWN_MASK);
+    return distro ? toQString(distro->name) : QString();
+}
+
+QString iconPath(QStringView distro)
+{
+    const Distro *match = find(distro);
+    if (!match || match->icon.empty())
+        match = firstOf(namesIn(distro) & ICON_MASK);
+
+    return QStringLiteral(":/icons/") + (match ? toQString(match->icon) : QStringLiteral("tux.svg"));
+}
+
+PackageFamily packageFamily(QStringView image)
+{
+    PackageFamily family = PackageFamily::None;
+    quint64 names = namesIn(image);
+    while (names != 0) {
+        const PackageFamily candidate = DISTROS[qCountTrailingZeroBits(names)].family;
+        if (candidate != PackageFamily::None && (family == PackageFamily::None || candidate < family))
+            family = candidate;
+        names &= names - 1;
+    }
+    return family;
+}
+
+QString packageFamilyName(PackageFamily family)
+{
+    switch (family) {
+    case PackageFamily::Arch:
+        return QStringLiteral("arch");
+    case PackageFamily::Deb:
+        return QStringLiteral("deb");
+    case PackageFamily::Rpm:
+        return QStringLiteral("rpm");
+    case PackageFamily::None:
+        break;
+    }
+    return QString();
+}
+
+const ToolboxImage *findToolboxImage(QStringView image)
+{
+    const int index = TOOLBOX_IMAGE_HASH.index(image);
+    if (index < 0)
+        return nullptr;
+
+    const std::string_view candidate = TOOLBOX_IMAGES[index].image;
+    // Image references are case sensitive
+    if (image.compare(QLatin1String(candidate.data(), qsizetype(candidate.size()))) != 0)
+        return nullptr;
+    return &TOOLBOX_IMAGES[index];
+}
+}
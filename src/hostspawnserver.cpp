@@ -0,0 +1,265 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "hostspawnserver.h"
+#include "commandrunner.h"
+#include <QDebug>
+#include <QFile>
+#include <utility>
+
+static QByteArray shellQuote(const QString &argument)
+{
+    QByteArray quoted = argument.toUtf8();
+    quoted.replace('\'', "'\\''");
+    return '\'' + quoted + '\'';
+}
+
+HostSpawnServer::HostSpawnServer(const QStringList &launcher, QObject *parent)
+    : QObject(parent)
+    , m_launcher(launcher)
+{
+}
+
+HostSpawnServer::~HostSpawnServer()
+{
+    if (m_process) {
+        // The helper exits by itself once its stdin is closed
+        m_process->closeWriteChannel();
+    }
+}
+
+QStringList HostSpawnServer::flatpakLauncher()
+{
+    return {"flatpak-spawn", "--host"};
+}
+
+bool HostSpawnServer::canTransport(const QStringList &command)
+{
+    if (command.isEmpty())
+        return false;
+
+    for (const QString &argument : command) {
+        if (argument.contains('\n'))
+            return false;
+    }
+    return true;
+}
+
+bool HostSpawnServer::isAvailable() const
+{
+    return !m_failed;
+}
+
+bool HostSpawnServer::ensureStarted()
+{
+    if (m_process)
+        return true;
+    if (m_failed)
+        return false;
+
+    QFile script(":/helpers/host-spawn.sh");
+    if (!script.open(QIODevice::ReadOnly)) {
+        qWarning() << "Host spawn helper script is missing from the resources";
+        m_failed = true;
+        return false;
+    }
+
+    m_process = new QProcess(this);
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &HostSpawnServer::readOutput);
+    connect(m_process, &QProcess::readyReadStandardError, this, [this]() {
+        qWarning() << "Host spawn helper:" << m_process->readAllStandardError().trimmed();
+    });
+    connect(m_process, &QProcess::finished, this, &HostSpawnServer::handleHelperExit);
+    connect(m_process, &QProcess::errorOccurred, this, &HostSpawnServer::handleHelperError);
+
+    const QStringList program = m_launcher + QStringList{"sh", "-c", QString::fromUtf8(script.readAll()), "kontainer-host-spawn"};
+    m_process->start(program.first(), program.mid(1));
+    return true;
+}
+
+quint64 HostSpawnServer::submit(CommandJob *job)
+{
+    if (!ensureStarted()) {
+        job->startProcess(m_launcher + job->command());
+        return 0;
+    }
+
+    const quint64 id = m_nextId++;
+    m_jobs.insert(id, job);
+
+    QByteArray request = "R " + QByteArray::number(id);
+    for (const QString &argument : job->command()) {
+        request += ' ' + shellQuote(argument);
+    }
+    request += '\n';
+    m_process->write(request);
+
+    return id;
+}
+
+void HostSpawnServer::forget(quint64 id)
+{
+    m_jobs.remove(id);
+}
+
+void HostSpawnServer::cancel(quint64 id)
+{
+    m_jobs.remove(id);
+    if (!m_process)
+        return;
+
+    const auto group = m_processGroups.constFind(id);
+    if (group == m_processGroups.cend()) {
+        m_pendingKills.insert(id);
+        return;
+    }
+
+    m_process->write("K " + QByteArray::number(*group) + '\n');
+    m_processGroups.erase(group);
+}
+
+void HostSpawnServer::readOutput()
+{
+    m_buffer += m_process->readAllStandardOutput();
+
+    // Slots reached from here may spin a nested event loop, only the outermost call dispatches
+    if (m_dispatching)
+        return;
+    m_dispatching = true;
+
+    qsizetype end;
+    while ((end = m_buffer.lastIndexOf('\n')) >= 0) {
+        const QByteArray batch = m_buffer.left(end);
+        m_buffer.remove(0, end + 1);
+
+        qsizetype start = 0;
+        while (start <= batch.size()) {
+            qsizetype next = batch.indexOf('\n', start);
+            if (next < 0)
+                next = batch.size();
+            handleLine(batch.mid(start, next - start));
+            start = next + 1;
+        }
+    }
+
+    m_dispatching = false;
+}
+
+void HostSpawnServer::handleLine(const QByteArray &line)
+{
+    // <id> <O|E|X|P> <payload>
+    const qsizetype idEnd = line.indexOf(' ');
+    if (idEnd <= 0 || line.size() < idEnd + 2)
+        return;
+
+    m_helperResponded = true;
+
+    const quint64 id = line.left(idEnd).toULongLong();
+    const char type = line.at(idEnd + 1);
+    QByteArray payload = line.mid(idEnd + 3);
+
+    // Long lines arrive in pieces so the helper's writes stay atomic, decode them once complete
+    if (type == 'o' || type == 'e') {
+        if (m_jobs.value(id))
+            m_partialLines[{id, type == 'o' ? 'O' : 'E'}] += payload;
+        return;
+    }
+    if (type == 'O' || type == 'E')
+        payload.prepend(m_partialLines.take({id, type}));
+
+    if (type == 'P') {
+        const qint64 group = payload.toLongLong();
+        if (group <= 0)
+            return;
+        if (m_pendingKills.remove(id)) {
+            m_process->write("K " + QByteArray::number(group) + '\n');
+        } else if (CommandJob *job = m_jobs.value(id)) {
+            m_processGroups.insert(id, group);
+            emit job->started();
+        }
+        return;
+    }
+
+    if (type == 'X') {
+        m_processGroups.remove(id);
+        m_pendingKills.remove(id);
+        m_partialLines.remove({id, 'O'});
+        m_partialLines.remove({id, 'E'});
+    }
+
+    CommandJob *job = m_jobs.value(id);
+    if (!job) {
+        // Late output of a job that already timed out, was cancelled or destroyed
+        if (type == 'X')
+            m_jobs.remove(id);
+        return;
+    }
+
+    switch (type) {
+    case 'O':
+        job->receiveOutput(QProcess::StandardOutput, QString::fromUtf8(payload) + '\n');
+        break;
+    case 'E':
+        job->receiveOutput(QProcess::StandardError, QString::fromUtf8(payload) + '\n');
+        break;
+    case 'X':
+        m_jobs.remove(id);
+        job->receiveExit(payload.toInt(), QProcess::NormalExit);
+        break;
+    default:
+        break;
+    }
+}
+
+void HostSpawnServer::handleHelperExit()
+{
+    // A helper that never answered could not run on the host at all
+    if (!m_helperResponded) {
+        fallBackToDirectSpawn();
+        return;
+    }
+
+    qWarning() << "Host spawn helper exited, it will be restarted on the next command";
+
+    const auto jobs = std::exchange(m_jobs, {});
+    m_process->deleteLater();
+    m_process = nullptr;
+    m_buffer.clear();
+    m_processGroups.clear();
+    m_pendingKills.clear();
+    m_partialLines.clear();
+    m_helperResponded = false;
+
+    for (const QPointer<CommandJob> &job : jobs) {
+        if (job)
+            job->receiveExit(-1, QProcess::CrashExit);
+    }
+}
+
+void HostSpawnServer::handleHelperError(QProcess::ProcessError error)
+{
+    if (error == QProcess::FailedToStart) {
+        qWarning() << "Could not start the host spawn helper:" << m_process->errorString();
+        fallBackToDirectSpawn();
+    }
+}
+
+void HostSpawnServer::fallBackToDirectSpawn()
+{
+    qWarning() << "Host spawn helper unavailable, falling back to one process per command";
+    m_failed = true;
+
+    // Nothing ran on the host yet, so hand the queued jobs their own processes
+    const auto jobs = std::exchange(m_jobs, {});
+    m_process->deleteLater();
+    m_process = nullptr;
+    m_buffer.clear();
+    m_processGroups.clear();
+    m_pendingKills.clear();
+    m_partialLines.clear();
+
+    for (const QPointer<CommandJob> &job : jobs) {
+        if (job)
+            job->startProcess(m_launcher + job->command());
+    }
+}
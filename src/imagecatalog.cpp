@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "imagecatalog.h"
+#include "distroclassifier.h"
+#include "distrotable.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace
+{
+QString cachePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/image-catalog.cache");
+}
+}
+
+ImageCatalog::ImageCatalog(CommandRunner *runner, QObject *parent)
+    : QObject(parent)
+    , m_runner(runner)
+{
+}
+
+QFuture<ImageList> ImageCatalog::images()
+{
+    if (m_loaded)
+        return QtFuture::makeReadyValueFuture(m_images);
+    if (m_loading)
+        return m_pending;
+    return start(true);
+}
+
+QFuture<ImageList> ImageCatalog::reload()
+{
+    m_loaded = false;
+    return start(false);
+}
+
+QFuture<ImageList> ImageCatalog::start(bool useCache)
+{
+    const int generation = ++m_generation;
+    m_loading = true;
+    m_pending = load(useCache).then(this, [this, generation](const ImageList &images) {
+        // A reload started meanwhile, its result is the one to keep
+        if (generation != m_generation)
+            return images;
+
+        m_loading = false;
+        // A failed listing is tried again by the next caller, a failed reload keeps the old list
+        if (!images.isEmpty())
+            m_images = images;
+        m_loaded = !m_images.isEmpty();
+        return m_images;
+    });
+    return m_pending;
+}
+
+QFuture<ImageList> ImageCatalog::load(bool useCache)
+{
+    // "distrobox: 1.8.1.2", a new release may well offer other images
+    return m_runner->run({"distrobox", "version"}).then(this, [this, useCache](const CommandResult &result) {
+        const QString version = result.success() ? result.standardOutput.trimmed() : QString();
+
+        QStringList urls;
+        if (useCache && !version.isEmpty() && loadCache(version, &urls))
+            return QtFuture::makeReadyValueFuture(toImages(urls));
+        return fetch(version);
+    }).unwrap();
+}
+
+QFuture<ImageList> ImageCatalog::fetch(const QString &distroboxVersion)
+{
+    return m_runner->run({"distrobox", "create", "-C"}).then(this, [this, distroboxVersion](const CommandResult &result) {
+        if (!result.success()) {
+            qWarning() << "Failed to list distrobox images, exit code" << result.exitCode;
+            return ImageList();
+        }
+
+        QStringList urls;
+        for (const QString &line : result.standardOutput.split('\n', Qt::SkipEmptyParts)) {
+            const QString url = line.trimmed();
+            if (!url.isEmpty())
+                urls << url;
+        }
+        if (!distroboxVersion.isEmpty() && !urls.isEmpty())
+            saveCache(distroboxVersion, urls);
+        return toImages(urls);
+    });
+}
+
+ImageList ImageCatalog::toImages(const QStringList &urls)
+{
+    ImageList images;
+    images.reserve(urls.size());
+    for (const QString &url : urls) {
+        ImageInfo image;
+        const QString distro = DistroClassifier::classify(url);
+        image.url = url;
+        image.name = url.split('/').last();
+        image.distro = InternedString(distro);
+        image.icon = InternedString(DistroTable::iconPath(distro));
+        image.display = url;
+        images.append(image);
+    }
+    return images;
+}
+
+bool ImageCatalog::loadCache(const QString &distroboxVersion, QStringList *urls) const
+{
+    QFile file(cachePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION)
+        return false;
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    QString cachedFor;
+    QDateTime fetchedAt;
+    stream >> cachedFor >> fetchedAt >> *urls;
+    if (stream.status() != QDataStream::Ok || urls->isEmpty())
+        return false;
+
+    return cachedFor == distroboxVersion && fetchedAt.secsTo(QDateTime::currentDateTimeUtc()) < CACHE_TTL_SECS;
+}
+
+void ImageCatalog::saveCache(const QString &distroboxVersion, const QStringList &urls) const
+{
+    const QString path = cachePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not write image catalog cache" << path << file.errorString();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << CACHE_MAGIC << CACHE_VERSION;
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << distroboxVersion << QDateTime::currentDateTimeUtc() << urls;
+    if (!file.commit())
+        qWarning() << "Could not write image catalog cache" << path << file.errorString();
+}
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "imagesearch.h"
+#include <QStringList>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+ImageList ImageSearch::filter(const ImageList &images, const QString &query)
+{
+    ImageList filteredImages;
+
+    for (const ImageInfo &image : images) {
+        if (image.name.contains(query, Qt::CaseInsensitive) || image.distro.toString().contains(query, Qt::CaseInsensitive)
+            || image.url.contains(query, Qt::CaseInsensitive)) {
+            filteredImages.append(image);
+        }
+    }
+
+    return filteredImages;
+}
+
+namespace
+{
+quint64 trigramKey(const QChar *chars)
+{
+    return quint64(chars[0].unicode()) << 32 | quint64(chars[1].unicode()) << 16 | chars[2].unicode();
+}
+
+// Tags that always point at the newest release
+bool isRollingTag(QStringView tag)
+{
+    static const QStringList rolling = {"latest", "rawhide", "edge", "main", "current", "testing", "unstable", "cauldron"};
+    return std::any_of(rolling.cbegin(), rolling.cend(), [tag](const QString &name) {
+        return tag.startsWith(name);
+    });
+}
+
+// "24.04" ranks above "22.04", "stream10" above "stream9"
+qint64 tagRank(QStringView tag)
+{
+    if (tag.isEmpty())
+        return 0;
+    if (isRollingTag(tag))
+        return std::numeric_limits<qint64>::max();
+
+    qint64 rank = 0;
+    int groups = 0;
+    qint64 number = -1;
+    for (qsizetype i = 0; i <= tag.size() && groups < 3; ++i) {
+        const QChar c = i < tag.size() ? tag.at(i) : QChar();
+        if (c.isDigit()) {
+            number = qMax<qint64>(number, 0) * 10 + c.digitValue();
+            if (number > 9999)
+                number = 9999;
+        } else if (number >= 0) {
+            rank = rank * 10000 + number;
+            number = -1;
+            ++groups;
+        }
+    }
+    while (groups++ < 3) {
+        rank *= 10000;
+    }
+    return rank;
+}
+
+bool isWordStart(const QString &text, qsizetype position)
+{
+    if (position == 0)
+        return true;
+    const QChar before = text.at(position - 1);
+    return before == '/' || before == '-' || before == '_' || before == '.' || before == ':' || before == '\n';
+}
+}
+
+ImageSearchIndex::ImageSearchIndex(const ImageList &images)
+    : m_images(images)
+{
+    m_entries.reserve(images.size());
+    for (int row = 0; row < images.size(); ++row) {
+        const ImageInfo &image = images.at(row);
+
+        Entry entry;
+        entry.distro = image.distro.toString().toLower();
+        entry.text = image.url.toLower() + QLatin1Char('\n') + entry.distro + QLatin1Char('\n') + image.version.toLower();
+        entry.nameStart = image.url.lastIndexOf('/') + 1;
+        entry.local = image.local;
+
+        const QStringView name = QStringView(image.url).mid(entry.nameStart);
+        const qsizetype colon = name.lastIndexOf(':');
+        entry.tagRank = tagRank(image.version.isEmpty() ? (colon < 0 ? QStringView() : name.mid(colon + 1)) : QStringView(image.version));
+
+        for (qsizetype i = 0; i + 3 <= entry.text.size(); ++i) {
+            QList<int> &rows = m_trigrams[trigramKey(entry.text.constData() + i)];
+            if (rows.isEmpty() || rows.last() != row)
+                rows.append(row);
+        }
+        m_entries.append(entry);
+    }
+}
+
+QList<int> ImageSearchIndex::candidates(const QString &query) const
+{
+    QList<int> rows;
+    if (query.size() < 3) {
+        rows.reserve(m_entries.size());
+        for (int row = 0; row < m_entries.size(); ++row) {
+            rows.append(row);
+        }
+        return rows;
+    }
+
+    // Smallest posting list first, every further trigram can only narrow it down
+    QList<const QList<int> *> postings;
+    for (qsizetype i = 0; i + 3 <= query.size(); ++i) {
+        const auto it = m_trigrams.constFind(trigramKey(query.constData() + i));
+        if (it == m_trigrams.cend())
+            return {};
+        postings.append(&*it);
+    }
+    std::sort(postings.begin(), postings.end(), [](const QList<int> *a, const QList<int> *b) {
+        return a->size() < b->size();
+    });
+
+    rows = *postings.first();
+    for (qsizetype i = 1; i < postings.size() && !rows.isEmpty(); ++i) {
+        QList<int> narrowed;
+        std::set_intersection(rows.cbegin(), rows.cend(), postings.at(i)->cbegin(), postings.at(i)->cend(), std::back_inserter(narrowed));
+        rows = narrowed;
+    }
+    return rows;
+}
+
+int ImageSearchIndex::score(const Entry &entry, const QString &query, qsizetype position) const
+{
+    if (entry.distro == query)
+        return 0;
+    if (QStringView(entry.text).mid(entry.nameStart).startsWith(query))
+        return 1;
+    return isWordStart(entry.text, position) ? 2 : 3;
+}
+
+QList<int> ImageSearchIndex::search(const QString &query, const QList<int> *previous) const
+{
+    const QString needle = query.trimmed().toLower();
+    if (needle.isEmpty())
+        return candidates(needle);
+
+    struct Hit {
+        int score;
+        bool local;
+        qint64 tagRank;
+        int row;
+    };
+
+    // Trigrams only say which rows may match, the substring check decides
+    QList<Hit> hits;
+    for (const int row : previous ? *previous : candidates(needle)) {
+        const Entry &entry = m_entries.at(row);
+        const qsizetype position = entry.text.indexOf(needle);
+        if (position >= 0)
+            hits.append({score(entry, needle, position), entry.local, entry.tagRank, row});
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const Hit &a, const Hit &b) {
+        if (a.score != b.score)
+            return a.score < b.score;
+        if (a.local != b.local)
+            return a.local;
+        if (a.tagRank != b.tagRank)
+            return a.tagRank > b.tagRank;
+        return a.row < b.row;
+    });
+
+    QList<int> rows;
+    rows.reserve(hits.size());
+    for (const Hit &hit : std::as_const(hits)) {
+        rows.append(hit.row);
+    }
+    return rows;
+}
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "jobprogressdialog.h"
+#include <KLocalizedString>
+#include <QHBoxLayout>
+#include <QIcon>
+#include <QVBoxLayout>
+
+JobProgressDialog::JobProgressDialog(JobScheduler *scheduler, const QList<quint64> &jobIds, QWidget *parent)
+    : QDialog(parent)
+    , m_scheduler(scheduler)
+{
+    setWindowTitle(i18n("Upgrading containers..."));
+    resize(700, 450);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    m_tabs = new QTabWidget(this);
+    m_tabs->setDocumentMode(true);
+    m_tabs->setUsesScrollButtons(true);
+    mainLayout->addWidget(m_tabs);
+
+    for (quint64 id : jobIds) {
+        const JobInfo job = m_scheduler->job(id);
+
+        JobTab tab;
+        tab.output = new LogView(m_tabs);
+        tab.index = m_tabs->addTab(tab.output, job.container == JobScheduler::AllContainers ? i18n("All containers") : job.container);
+        m_jobTabs.insert(id, tab);
+
+        updateJob(job);
+    }
+
+    QHBoxLayout *bottomLayout = new QHBoxLayout();
+    m_summaryLabel = new QLabel(this);
+    bottomLayout->addWidget(m_summaryLabel);
+    bottomLayout->addStretch();
+
+    m_cancelBtn = new QPushButton(QIcon::fromTheme("dialog-cancel"), i18n("Cancel All"), this);
+    connect(m_cancelBtn, &QPushButton::clicked, this, [this]() {
+        for (auto it = m_jobTabs.cbegin(); it != m_jobTabs.cend(); ++it) {
+            m_scheduler->cancel(it.key());
+        }
+    });
+    bottomLayout->addWidget(m_cancelBtn);
+
+    // Closing only hides the output, the jobs keep running and stay listed in the jobs dialog
+    m_closeBtn = new QPushButton(QIcon::fromTheme("window-close"), i18n("Close"), this);
+    connect(m_closeBtn, &QPushButton::clicked, this, &QDialog::accept);
+    bottomLayout->addWidget(m_closeBtn);
+    mainLayout->addLayout(bottomLayout);
+
+    connect(m_scheduler, &JobScheduler::jobChanged, this, &JobProgressDialog::updateJob);
+    connect(m_scheduler, &JobScheduler::jobOutput, this, &JobProgressDialog::appendOutput);
+    connect(m_scheduler, &JobScheduler::jobFinished, this, &JobProgressDialog::finishJob);
+
+    updateSummary();
+}
+
+void JobProgressDialog::updateJob(const JobInfo &job)
+{
+    const auto it = m_jobTabs.constFind(job.id);
+    if (it == m_jobTabs.cend())
+        return;
+
+    QIcon icon;
+    switch (job.state) {
+    case JobInfo::Queued:
+        icon = QIcon::fromTheme("chronometer-pause");
+        break;
+    case JobInfo::Running:
+        icon = QIcon::fromTheme("chronometer-start");
+        break;
+    case JobInfo::Finished:
+        icon = QIcon::fromTheme("dialog-ok");
+        break;
+    case JobInfo::Failed:
+        icon = QIcon::fromTheme("dialog-error");
+        break;
+    case JobInfo::Cancelled:
+        icon = QIcon::fromTheme("dialog-cancel");
+        break;
+    }
+    m_tabs->setTabIcon(it->index, icon);
+}
+
+void JobProgressDialog::appendOutput(quint64 id, const QString &chunk)
+{
+    const auto it = m_jobTabs.constFind(id);
+    if (it == m_jobTabs.cend())
+        return;
+
+    it->output->appendOutput(chunk);
+}
+
+void JobProgressDialog::finishJob(const JobInfo &job, const CommandResult &result)
+{
+    const auto it = m_jobTabs.constFind(job.id);
+    if (it == m_jobTabs.cend())
+        return;
+
+    ++m_finished;
+    if (result.success()) {
+        it->output->appendOutput(QLatin1Char('\n') + i18n("Finished successfully") + QLatin1Char('\n'));
+    } else if (result.cancelled) {
+        ++m_failed;
+        it->output->appendOutput(QLatin1Char('\n') + i18n("Cancelled") + QLatin1Char('\n'));
+    } else {
+        ++m_failed;
+        it->output->appendOutput(QLatin1Char('\n') + i18n("Error: Command failed with exit code %1", result.exitCode) + QLatin1Char('\n'));
+    }
+    if (m_finished == m_jobTabs.size()) {
+        m_cancelBtn->setEnabled(false);
+    }
+    updateSummary();
+}
+
+void JobProgressDialog::updateSummary()
+{
+    QString summary = i18n("%1 of %2 finished", m_finished, m_jobTabs.size());
+    if (m_failed > 0)
+        summary += i18n(", %1 failed", m_failed);
+    m_summaryLabel->setText(summary);
+}
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "jobscheduler.h"
+#include <QSettings>
+#include <algorithm>
+
+JobScheduler::JobScheduler(CommandRunner *runner, QObject *parent)
+    : QObject(parent)
+    , m_runner(runner)
+{
+    qRegisterMetaType<JobInfo>();
+
+    QSettings settings;
+    m_maxConcurrent = qMax(1, settings.value("jobs/maxConcurrent", 3).toInt());
+}
+
+int JobScheduler::maxConcurrent() const
+{
+    return m_maxConcurrent;
+}
+
+void JobScheduler::setMaxConcurrent(int maxConcurrent)
+{
+    maxConcurrent = qMax(1, maxConcurrent);
+    if (maxConcurrent == m_maxConcurrent)
+        return;
+
+    m_maxConcurrent = maxConcurrent;
+    QSettings settings;
+    settings.setValue("jobs/maxConcurrent", m_maxConcurrent);
+    schedule();
+}
+
+quint64 JobScheduler::enqueue(const QString &container, const QString &title, const QStringList &command, const QString &group)
+{
+    JobInfo job;
+    job.id = m_nextId++;
+    job.container = container;
+    job.group = group;
+    job.title = title;
+    job.command = command;
+    job.queuedAt = QDateTime::currentDateTime();
+
+    m_jobs.insert(job.id, job);
+    m_pending.append(job.id);
+    emit jobChanged(job);
+
+    schedule();
+    return job.id;
+}
+
+void JobScheduler::cancel(quint64 id)
+{
+    auto it = m_jobs.find(id);
+    if (it == m_jobs.end())
+        return;
+
+    if (it->state == JobInfo::Running) {
+        m_tokens.value(id).cancel();
+        return;
+    }
+    if (it->state != JobInfo::Queued)
+        return;
+
+    m_pending.removeOne(id);
+    it->state = JobInfo::Cancelled;
+    it->finishedAt = QDateTime::currentDateTime();
+    const JobInfo info = *it;
+
+    CommandResult result;
+    result.command = info.command;
+    result.cancelled = true;
+
+    retire(id);
+    emit jobChanged(info);
+    emit jobFinished(info, result);
+    // Later jobs of the same container may have been waiting behind this one
+    schedule();
+}
+
+JobInfo JobScheduler::job(quint64 id) const
+{
+    return m_jobs.value(id);
+}
+
+QList<JobInfo> JobScheduler::jobs() const
+{
+    QList<JobInfo> jobs = m_jobs.values();
+    std::sort(jobs.begin(), jobs.end(), [](const JobInfo &a, const JobInfo &b) {
+        return a.id < b.id;
+    });
+    return jobs;
+}
+
+OutputSink *JobScheduler::output(quint64 id) const
+{
+    return m_outputs.value(id);
+}
+
+int JobScheduler::runningCount() const
+{
+    return m_running;
+}
+
+int JobScheduler::queuedCount() const
+{
+    return m_pending.size();
+}
+
+void JobScheduler::schedule()
+{
+    quint64 id;
+    while ((id = nextStartable()) != 0) {
+        m_pending.removeOne(id);
+        startJob(id);
+    }
+}
+
+quint64 JobScheduler::nextStartable() const
+{
+    if (m_running >= m_maxConcurrent || m_busyContainers.contains(AllContainers))
+        return 0;
+
+    // Containers and groups that already have an earlier job waiting, later ones must not overtake it
+    QSet<QString> blocked;
+    QSet<QString> blockedGroups;
+    for (quint64 id : m_pending) {
+        const JobInfo &job = m_jobs.find(id).value();
+
+        if (job.container == AllContainers) {
+            // Nothing queued after a job for every container may start before it
+            return m_running == 0 ? id : 0;
+        }
+
+        const bool groupFree = job.group.isEmpty() || (!blockedGroups.contains(job.group) && !m_busyGroups.contains(job.group));
+        if (groupFree && !blocked.contains(job.container) && !m_busyContainers.contains(job.container))
+            return id;
+
+        blocked.insert(job.container);
+        if (!job.group.isEmpty())
+            blockedGroups.insert(job.group);
+    }
+    return 0;
+}
+
+void JobScheduler::startJob(quint64 id)
+{
+    JobInfo &job = m_jobs[id];
+    job.state = JobInfo::Running;
+    job.startedAt = QDateTime::currentDateTime();
+    m_busyContainers.insert(job.container);
+    if (!job.group.isEmpty())
+        m_busyGroups.insert(job.group);
+    ++m_running;
+
+    OutputSink *sink = new OutputSink(this);
+    m_outputs.insert(id, sink);
+
+    const CancellationToken token;
+    m_tokens.insert(id, token);
+
+    CommandJob *process = m_runner->start(job.command, QProcess::MergedChannels, 0, token);
+    process->setOutputSink(sink);
+    connect(process, &CommandJob::outputReceived, this, [this, id](const QString &chunk) {
+        emit jobOutput(id, chunk);
+    });
+    connect(process, &CommandJob::finished, this, [this, id](const CommandResult &result) {
+        auto it = m_jobs.find(id);
+        if (it == m_jobs.end())
+            return;
+
+        if (result.cancelled) {
+            it->state = JobInfo::Cancelled;
+        } else {
+            it->state = result.success() ? JobInfo::Finished : JobInfo::Failed;
+        }
+        it->exitCode = result.exitCode;
+        it->finishedAt = QDateTime::currentDateTime();
+        const JobInfo info = *it;
+
+        m_busyContainers.remove(info.container);
+        m_busyGroups.remove(info.group);
+        m_tokens.remove(id);
+        --m_running;
+
+        retire(id);
+        emit jobChanged(info);
+        emit jobFinished(info, result);
+        schedule();
+    });
+
+    const JobInfo info = job;
+    emit jobChanged(info);
+}
+
+void JobScheduler::retire(quint64 id)
+{
+    m_finished.append(id);
+    while (m_finished.size() > FINISHED_HISTORY) {
+        const quint64 expired = m_finished.takeFirst();
+        m_jobs.remove(expired);
+        delete m_outputs.take(expired);
+    }
+}
@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "jobsdialog.h"
+#include <KLocalizedString>
+#include <QDialogButtonBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QIcon>
+#include <QPlainTextEdit>
+#include <QSet>
+#include <QVBoxLayout>
+
+enum JobColumn {
+    ContainerColumn,
+    TaskColumn,
+    StateColumn,
+    DurationColumn,
+};
+
+static QString stateText(const JobInfo &job)
+{
+    switch (job.state) {
+    case JobInfo::Queued:
+        return i18n("Queued");
+    case JobInfo::Running:
+        return i18n("Running");
+    case JobInfo::Finished:
+        return i18n("Finished");
+    case JobInfo::Failed:
+        return i18n("Failed (exit code %1)", job.exitCode);
+    case JobInfo::Cancelled:
+        return i18n("Cancelled");
+    }
+    return QString();
+}
+
+static QIcon stateIcon(JobInfo::State state)
+{
+    switch (state) {
+    case JobInfo::Queued:
+        return QIcon::fromTheme("chronometer-pause");
+    case JobInfo::Running:
+        return QIcon::fromTheme("chronometer-start");
+    case JobInfo::Finished:
+        return QIcon::fromTheme("dialog-ok");
+    case JobInfo::Failed:
+        return QIcon::fromTheme("dialog-error");
+    case JobInfo::Cancelled:
+        return QIcon::fromTheme("dialog-cancel");
+    }
+    return QIcon();
+}
+
+static QString durationText(const JobInfo &job)
+{
+    if (!job.startedAt.isValid())
+        return QString();
+
+    const QDateTime end = job.finishedAt.isValid() ? job.finishedAt : QDateTime::currentDateTime();
+    const qint64 seconds = job.startedAt.secsTo(end);
+    return QStringLiteral("%1:%2").arg(seconds / 60).arg(seconds % 60, 2, 10, QLatin1Char('0'));
+}
+
+JobsDialog::JobsDialog(JobScheduler *scheduler, QWidget *parent)
+    : QDialog(parent)
+    , m_scheduler(scheduler)
+{
+    setWindowTitle(i18n("Jobs"));
+    resize(600, 350);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    m_jobsTree = new QTreeWidget(this);
+    m_jobsTree->setHeaderLabels({i18n("Container"), i18n("Task"), i18n("State"), i18n("Duration")});
+    m_jobsTree->setRootIsDecorated(false);
+    m_jobsTree->setUniformRowHeights(true);
+    m_jobsTree->header()->setSectionResizeMode(TaskColumn, QHeaderView::Stretch);
+    mainLayout->addWidget(m_jobsTree);
+
+    QHBoxLayout *bottomLayout = new QHBoxLayout();
+    m_summaryLabel = new QLabel(this);
+    bottomLayout->addWidget(m_summaryLabel);
+    bottomLayout->addStretch();
+
+    m_showLogBtn = new QPushButton(QIcon::fromTheme("text-x-log"), i18n("Show Log"), this);
+    m_showLogBtn->setEnabled(false);
+    connect(m_showLogBtn, &QPushButton::clicked, this, &JobsDialog::showLog);
+
+    m_cancelJobBtn = new QPushButton(QIcon::fromTheme("dialog-cancel"), i18n("Cancel Job"), this);
+    m_cancelJobBtn->setEnabled(false);
+    connect(m_cancelJobBtn, &QPushButton::clicked, this, [this]() {
+        const quint64 id = selectedJob();
+        if (id != 0)
+            m_scheduler->cancel(id);
+    });
+
+    connect(m_jobsTree, &QTreeWidget::itemSelectionChanged, this, &JobsDialog::updateButtons);
+    connect(m_jobsTree, &QTreeWidget::itemDoubleClicked, this, &JobsDialog::showLog);
+    bottomLayout->addWidget(m_showLogBtn);
+    bottomLayout->addWidget(m_cancelJobBtn);
+
+    bottomLayout->addWidget(new QLabel(i18n("Parallel jobs:"), this));
+    m_concurrencySpin = new QSpinBox(this);
+    m_concurrencySpin->setRange(1, 16);
+    m_concurrencySpin->setValue(m_scheduler->maxConcurrent());
+    connect(m_concurrencySpin, &QSpinBox::valueChanged, m_scheduler, &JobScheduler::setMaxConcurrent);
+    bottomLayout->addWidget(m_concurrencySpin);
+    mainLayout->addLayout(bottomLayout);
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    mainLayout->addWidget(buttons);
+
+    for (const JobInfo &job : m_scheduler->jobs()) {
+        updateJob(job);
+    }
+    connect(m_scheduler, &JobScheduler::jobChanged, this, &JobsDialog::updateJob);
+
+    // Running jobs have no events of their own, keep their durations ticking
+    m_durationTimer = new QTimer(this);
+    m_durationTimer->setInterval(1000);
+    connect(m_durationTimer, &QTimer::timeout, this, &JobsDialog::updateDurations);
+    m_durationTimer->start();
+
+    updateSummary();
+}
+
+void JobsDialog::updateJob(const JobInfo &job)
+{
+    QTreeWidgetItem *item = m_items.value(job.id);
+    if (!item) {
+        item = new QTreeWidgetItem(m_jobsTree);
+        item->setText(ContainerColumn, job.container == JobScheduler::AllContainers ? i18n("All containers") : job.container);
+        item->setText(TaskColumn, job.title);
+        item->setToolTip(TaskColumn, job.command.join(' '));
+        item->setData(ContainerColumn, Qt::UserRole, job.id);
+        m_items.insert(job.id, item);
+    }
+
+    item->setIcon(StateColumn, stateIcon(job.state));
+    item->setText(StateColumn, stateText(job));
+    item->setText(DurationColumn, durationText(job));
+
+    // A job ending may push the oldest finished one out of the scheduler's history
+    if (job.state != JobInfo::Queued && job.state != JobInfo::Running)
+        removeExpiredJobs();
+
+    updateSummary();
+    updateButtons();
+}
+
+void JobsDialog::removeExpiredJobs()
+{
+    QSet<quint64> ids;
+    for (const JobInfo &job : m_scheduler->jobs()) {
+        ids.insert(job.id);
+    }
+
+    for (auto it = m_items.begin(); it != m_items.end();) {
+        if (ids.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        delete it.value();
+        it = m_items.erase(it);
+    }
+}
+
+void JobsDialog::updateDurations()
+{
+    for (auto it = m_items.cbegin(); it != m_items.cend(); ++it) {
+        const JobInfo job = m_scheduler->job(it.key());
+        if (job.state == JobInfo::Running)
+            it.value()->setText(DurationColumn, durationText(job));
+    }
+}
+
+void JobsDialog::showLog()
+{
+    const quint64 id = selectedJob();
+    if (id == 0)
+        return;
+
+    OutputSink *output = m_scheduler->output(id);
+    const JobInfo job = m_scheduler->job(id);
+
+    QDialog *logDialog = new QDialog(this);
+    logDialog->setAttribute(Qt::WA_DeleteOnClose);
+    logDialog->setWindowTitle(i18n("Log of %1 (%2)", job.title, job.container));
+    logDialog->resize(700, 450);
+
+    QVBoxLayout *layout = new QVBoxLayout(logDialog);
+    QPlainTextEdit *logView = new QPlainTextEdit(logDialog);
+    logView->setReadOnly(true);
+    logView->setLineWrapMode(QPlainTextEdit::NoWrap);
+    logView->setPlainText(output ? output->readAll() : i18n("No output available for this job."));
+    logView->moveCursor(QTextCursor::End);
+    layout->addWidget(logView);
+
+    if (output && !output->logFilePath().isEmpty()) {
+        QLabel *pathLabel = new QLabel(i18n("Full log: %1", output->logFilePath()), logDialog);
+        pathLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+        layout->addWidget(pathLabel);
+    }
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Close, logDialog);
+    connect(buttons, &QDialogButtonBox::rejected, logDialog, &QDialog::reject);
+    layout->addWidget(buttons);
+
+    logDialog->show();
+}
+
+quint64 JobsDialog::selectedJob() const
+{
+    const QList<QTreeWidgetItem *> selected = m_jobsTree->selectedItems();
+    return selected.isEmpty() ? 0 : selected.first()->data(ContainerColumn, Qt::UserRole).toULongLong();
+}
+
+void JobsDialog::updateButtons()
+{
+    const quint64 id = selectedJob();
+    const JobInfo::State state = m_scheduler->job(id).state;
+    m_showLogBtn->setEnabled(id != 0);
+    m_cancelJobBtn->setEnabled(id != 0 && (state == JobInfo::Queued || state == JobInfo::Running));
+}
+
+void JobsDialog::updateSummary()
+{
+    m_summaryLabel->setText(i18n("%1 running, %2 queued", m_scheduler->runningCount(), m_scheduler->queuedCount()));
+}
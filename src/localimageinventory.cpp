@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "localimageinventory.h"
+#include "imagecatalog.h"
+#include <QDebug>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace
+{
+LocalImageInventory::LocalImage imageFromJson(const QJsonObject &object)
+{
+    LocalImageInventory::LocalImage image;
+
+    // podman uses Names[]/RepoDigests[], docker one Repository/Tag/Digest per line
+    const QJsonValue names = object.value("Names");
+    if (names.isArray()) {
+        for (const QJsonValue &name : names.toArray()) {
+            image.names << name.toString();
+        }
+        for (const QJsonValue &digest : object.value("RepoDigests").toArray()) {
+            image.digests << digest.toString();
+        }
+        return image;
+    }
+
+    // Dangling images have neither a repository nor a tag
+    const QString repository = object.value("Repository").toString();
+    if (repository.isEmpty() || repository == "<none>")
+        return image;
+
+    const QString tag = object.value("Tag").toString();
+    if (!tag.isEmpty() && tag != "<none>")
+        image.names << repository + ':' + tag;
+    const QString digest = object.value("Digest").toString();
+    if (digest.startsWith("sha256:"))
+        image.digests << repository + '@' + digest;
+    return image;
+}
+}
+
+LocalImageInventory::LocalImageInventory(CommandRunner *runner, QObject *parent)
+    : QObject(parent)
+    , m_runner(runner)
+{
+}
+
+QFuture<ImageList> LocalImageInventory::images(const QString &manager)
+{
+    if (m_loaded && m_manager == manager)
+        return QtFuture::makeReadyValueFuture(m_images);
+    if (m_loading && m_pendingManager == manager)
+        return m_pending;
+
+    m_loading = true;
+    m_pendingManager = manager;
+    const int generation = m_generation;
+    m_pending = m_runner->run({manager, "images", "--format", "json"}).then(this, [this, manager, generation](const CommandResult &result) {
+        if (manager == m_pendingManager)
+            m_loading = false;
+
+        if (!result.success()) {
+            qWarning() << "Failed to list local images of" << manager << "exit code" << result.exitCode;
+            return ImageList();
+        }
+
+        store(manager, parse(result.standardOutput));
+        // Something pulled while the listing ran, the next caller lists again
+        m_loaded = generation == m_generation;
+        return m_images;
+    });
+    return m_pending;
+}
+
+bool LocalImageInventory::contains(const QString &manager, const QString &reference) const
+{
+    return manager == m_manager && m_references.contains(normalizeReference(reference));
+}
+
+void LocalImageInventory::invalidate()
+{
+    m_loaded = false;
+    ++m_generation;
+}
+
+void LocalImageInventory::store(const QString &manager, const QList<LocalImage> &images)
+{
+    m_manager = manager;
+    m_references.clear();
+
+    QStringList urls;
+    for (const LocalImage &image : images) {
+        for (const QString &name : image.names) {
+            const QString reference = normalizeReference(name);
+            if (reference.isEmpty() || m_references.contains(reference))
+                continue;
+            m_references.insert(reference);
+            urls << name;
+        }
+        for (const QString &digest : image.digests) {
+            m_references.insert(normalizeReference(digest));
+        }
+    }
+
+    m_images = ImageCatalog::toImages(urls);
+    for (ImageInfo &image : m_images) {
+        image.local = true;
+    }
+}
+
+ImageList LocalImageInventory::merge(const ImageList &catalog, const ImageList &local)
+{
+    QHash<QString, qsizetype> localRows;
+    for (qsizetype row = 0; row < local.size(); ++row) {
+        localRows.insert(normalizeReference(local.at(row).url), row);
+    }
+
+    ImageList merged;
+    ImageList remote;
+    QList<bool> listed(local.size(), false);
+    merged.reserve(catalog.size() + local.size());
+    for (ImageInfo image : catalog) {
+        const auto row = localRows.constFind(normalizeReference(image.url));
+        if (row == localRows.cend()) {
+            remote << image;
+            continue;
+        }
+        // The catalog entry has the nicer name, keep it
+        image.local = true;
+        listed[*row] = true;
+        merged << image;
+    }
+    for (qsizetype row = 0; row < local.size(); ++row) {
+        if (!listed.at(row))
+            merged << local.at(row);
+    }
+    merged += remote;
+    return merged;
+}
+
+QList<LocalImageInventory::LocalImage> LocalImageInventory::parse(const QString &output)
+{
+    QList<LocalImage> images;
+    const QByteArray data = output.trimmed().toUtf8();
+
+    QJsonParseError error;
+    if (data.startsWith('[')) {
+        const QJsonDocument document = QJsonDocument::fromJson(data, &error);
+        for (const QJsonValue &value : document.array()) {
+            images << imageFromJson(value.toObject());
+        }
+        return images;
+    }
+
+    for (const QByteArray &line : data.split('\n')) {
+        const QJsonDocument document = QJsonDocument::fromJson(line.trimmed(), &error);
+        if (error.error == QJsonParseError::NoError && document.isObject())
+            images << imageFromJson(document.object());
+    }
+    return images;
+}
+
+QString LocalImageInventory::normalizeReference(QStringView reference)
+{
+    QStringView name = reference.trimmed();
+    if (name.isEmpty())
+        return QString();
+
+    // A digest pins the image, a tag next to it says nothing more
+    QStringView digest;
+    const qsizetype at = name.indexOf(u'@');
+    if (at >= 0) {
+        digest = name.mid(at);
+        name = name.left(at);
+    }
+
+    // Only a colon in the last segment starts the tag, one before it is a registry port
+    QStringView tag;
+    const qsizetype colon = name.lastIndexOf(u':');
+    if (colon > name.lastIndexOf(u'/')) {
+        tag = name.mid(colon);
+        name = name.left(colon);
+    }
+
+    const QString suffix = !digest.isEmpty() ? digest.toString() : tag.isEmpty() ? QStringLiteral(":latest") : tag.toString();
+
+    // The first segment names a registry only if it looks like a host
+    const qsizetype slash = name.indexOf(u'/');
+    const QStringView domain = slash < 0 ? QStringView() : name.left(slash);
+    const bool dockerHub = domain == u"docker.io" || domain == u"index.docker.io";
+    if (!dockerHub && (domain.contains(u'.') || domain.contains(u':') || domain == u"localhost"))
+        return name.toString() + suffix;
+
+    // Docker Hub, where official images live under library/
+    const QStringView path = dockerHub ? name.mid(slash + 1) : name;
+    return QStringLiteral("docker.io/") + (path.contains(u'/') ? QString() : QStringLiteral("library/")) + path.toString() + suffix;
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "logview.h"
+#include <QFontDatabase>
+#include <QScrollBar>
+#include <QSettings>
+#include <utility>
+
+LogView::LogView(QWidget *parent)
+    : QPlainTextEdit(parent)
+{
+    setReadOnly(true);
+    setLineWrapMode(QPlainTextEdit::NoWrap);
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    QSettings settings;
+    setMaximumBlockCount(settings.value("jobs/logViewMaxLines", 5000).toInt());
+
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(33);
+    connect(m_flushTimer, &QTimer::timeout, this, &LogView::flush);
+}
+
+void LogView::appendOutput(const QString &chunk)
+{
+    if (chunk.isEmpty())
+        return;
+
+    m_pending += chunk;
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+}
+
+void LogView::flush()
+{
+    m_flushTimer->stop();
+    if (m_pending.isEmpty())
+        return;
+
+    QString text = std::exchange(m_pending, QString());
+    text.replace(QLatin1String("\r\n"), QLatin1String("\n"));
+
+    // A \r\n split across two batches is still just a line break
+    if (m_carriageReturn && text.startsWith('\n')) {
+        m_carriageReturn = false;
+    }
+
+    QScrollBar *scrollBar = verticalScrollBar();
+    const bool atBottom = scrollBar->value() == scrollBar->maximum();
+
+    QTextCursor cursor(document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+
+    const QStringList lines = text.split('\n');
+    for (qsizetype i = 0; i < lines.size(); ++i) {
+        if (i > 0) {
+            cursor.insertText(QStringLiteral("\n"));
+            m_carriageReturn = false;
+        }
+
+        const QString &line = lines.at(i);
+        if (line.isEmpty())
+            continue;
+
+        if (m_carriageReturn) {
+            clearCurrentLine(cursor);
+            m_carriageReturn = false;
+        }
+
+        // Only the last redraw of a progress line is worth rendering
+        const bool endsWithReturn = line.endsWith('\r');
+        const QString body = endsWithReturn ? line.chopped(1) : line;
+        const qsizetype lastReturn = body.lastIndexOf('\r');
+        if (lastReturn >= 0) {
+            clearCurrentLine(cursor);
+            cursor.insertText(body.mid(lastReturn + 1));
+        } else {
+            cursor.insertText(body);
+        }
+        m_carriageReturn = endsWithReturn;
+    }
+
+    cursor.endEditBlock();
+
+    if (atBottom) {
+        scrollBar->setValue(scrollBar->maximum());
+    }
+}
+
+void LogView::clearCurrentLine(QTextCursor &cursor)
+{
+    cursor.movePosition(QTextCursor::StartOfBlock, QTextCursor::KeepAnchor);
+    cursor.removeSelectedText();
+}
@@ -4,7 +4,11 @@
 #include "mainwindow.h"
 #include "appsdialog.h"
 #include "backend.h"
+#include "containerlistmodel.h"
 #include "createcontainerdialog.h"
+#include "jobprogressdialog.h"
+#include "jobsdialog.h"
+#include "logview.h"
 
 // Custom delegate for container list items
 class ContainerItemDelegate : public QStyledItemDelegate
@@ -32,21 +36,29 @@ public:
         }
 
         // Container data
-        QString image = index.data(Qt::UserRole + 3).toString();
-        QString distro = index.data(Qt::UserRole + 4).toString();
-        QString iconPath = index.data(Qt::UserRole + 5).toString();
-        bool isReady = index.data(Qt::UserRole + 6).toBool();
-        bool isEmptyPlaceholder = index.data(Qt::UserRole + 7).toBool();
+        QString image = index.data(ContainerListModel::ImageRole).toString();
+        QString distro = index.data(ContainerListModel::DistroRole).toString();
+        QString iconPath = index.data(ContainerListModel::IconRole).toString();
+        bool isReady = index.data(ContainerListModel::ReadyRole).toBool();
+        bool isEmptyPlaceholder = index.data(ContainerListModel::PlaceholderRole).toBool();
+
+        // Rows from the startup snapshot are dimmed until the runtime confirmed them
+        if (index.data(ContainerListModel::StaleRole).toBool())
+            painter->setOpacity(0.6);
 
         // Icon rectangle
         int iconSize = opt.rect.height() - 8;
         QRect iconRect(opt.rect.x() + 4, opt.rect.y() + 4, iconSize, iconSize);
 
-        // Load icon
+        // Load icon, decoded once per path and size instead of on every paint
         QPixmap icon;
 
         if (!iconPath.isEmpty()) {
-            icon.load(iconPath);
+            const QString cacheKey = iconPath + QLatin1Char('@') + QString::number(iconSize);
+            if (!QPixmapCache::find(cacheKey, &icon) && icon.load(iconPath)) {
+                icon = icon.scaled(iconSize, iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                QPixmapCache::insert(cacheKey, icon);
+            }
         }
 
         if (icon.isNull()) {
@@ -59,7 +71,7 @@ public:
 
         // Falls weiterhin kein Icon da ist, versuche es mit altIconPath
         if (icon.isNull()) {
-            QVariant altIconData = index.data(Qt::UserRole + 5);
+            QVariant altIconData = index.data(ContainerListModel::IconRole);
             if (altIconData.isValid() && !altIconData.isNull()) {
                 QString altPath = altIconData.toString();
                 QPixmap altIcon;
@@ -72,12 +84,17 @@ public:
 
         // Zeichne Icon
         if (!icon.isNull()) {
-            icon = icon.scaled(iconSize, iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            if (icon.width() > iconSize || icon.height() > iconSize)
+                icon = icon.scaled(iconSize, iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
             painter->drawPixmap(iconRect, icon);
         }
 
+        // Resource usage of running containers takes the right end of the row
+        const QList<ContainerStats> stats = index.data(ContainerListModel::StatsRole).value<QList<ContainerStats>>();
+        const int statsWidth = stats.isEmpty() ? 0 : STATS_WIDTH;
+
         // Haupttext (Name)
-        QRect nameRect = opt.rect.adjusted(iconSize + 12, 0, -30, -opt.rect.height() / 2);
+        QRect nameRect = opt.rect.adjusted(iconSize + 12, 0, -30 - statsWidth, -opt.rect.height() / 2);
         QString elidedName = opt.fontMetrics.elidedText(opt.text, Qt::ElideRight, nameRect.width());
         painter->drawText(nameRect, Qt::AlignLeft | Qt::AlignVCenter, elidedName);
 
@@ -90,10 +107,52 @@ public:
         textColor.setAlpha(180);
         painter->setPen(textColor);
 
-        QRect imageRect = opt.rect.adjusted(iconSize + 12, opt.rect.height() / 2, -30, 0);
+        QRect imageRect = opt.rect.adjusted(iconSize + 12, opt.rect.height() / 2, -30 - statsWidth, 0);
+        const QString backendName = index.data(ContainerListModel::BackendRole).toString();
+        if (!backendName.isEmpty())
+            image = backendName + QStringLiteral(" · ") + image;
+        const qint64 size = index.data(ContainerListModel::SizeRole).toLongLong();
+        if (size >= 0) {
+            const qint64 imageSize = index.data(ContainerListModel::ImageSizeRole).toLongLong();
+            const QLocale locale;
+            image += QStringLiteral(" · ")
+                + (imageSize >= 0 ? i18n("%1 + %2 image", locale.formattedDataSize(size), locale.formattedDataSize(imageSize))
+                                  : locale.formattedDataSize(size));
+        }
         QString elidedImage = opt.fontMetrics.elidedText(image, Qt::ElideRight, imageRect.width());
         painter->drawText(imageRect, Qt::AlignLeft | Qt::AlignVCenter, elidedImage);
 
+        if (!stats.isEmpty()) {
+            // CPU on the upper line, memory below, each as a sparkline with the latest value
+            const QRect statsRect(opt.rect.right() - 30 - STATS_WIDTH, opt.rect.top(), STATS_WIDTH, opt.rect.height());
+            const QRect cpuRect = statsRect.adjusted(0, 4, 0, -statsRect.height() / 2);
+            const QRect memoryRect = statsRect.adjusted(0, statsRect.height() / 2, 0, -4);
+
+            QList<qreal> cpu;
+            QList<qreal> memory;
+            qreal maxCpu = 100;
+            qreal maxMemory = 1;
+            for (const ContainerStats &sample : stats) {
+                cpu << sample.cpuPercent;
+                memory << sample.memoryBytes;
+                maxCpu = qMax(maxCpu, sample.cpuPercent);
+                maxMemory = qMax<qreal>(maxMemory, sample.memoryBytes);
+            }
+
+            const QColor highlight = (opt.state & QStyle::State_Selected) ? opt.palette.highlightedText().color() : opt.palette.highlight().color();
+            drawSparkline(painter, cpuRect.adjusted(0, 2, -SPARKLINE_LABEL_WIDTH, -2), cpu, maxCpu, highlight);
+            drawSparkline(painter, memoryRect.adjusted(0, 2, -SPARKLINE_LABEL_WIDTH, -2), memory, maxMemory, highlight);
+
+            painter->setPen(textColor);
+            const ContainerStats &latest = stats.last();
+            painter->drawText(cpuRect.adjusted(STATS_WIDTH - SPARKLINE_LABEL_WIDTH, 0, 0, 0),
+                              Qt::AlignRight | Qt::AlignVCenter,
+                              QStringLiteral("%1%").arg(qRound(latest.cpuPercent)));
+            painter->drawText(memoryRect.adjusted(STATS_WIDTH - SPARKLINE_LABEL_WIDTH, 0, 0, 0),
+                              Qt::AlignRight | Qt::AlignVCenter,
+                              QLocale().formattedDataSize(latest.memoryBytes, 0));
+        }
+
         painter->restore();
     }
 
@@ -103,77 +162,164 @@ public:
         size.setHeight(qMax(size.height(), 48));
         return size;
     }
+
+private:
+    static constexpr int STATS_WIDTH = 110;
+    static constexpr int SPARKLINE_LABEL_WIDTH = 56;
+
+    static void drawSparkline(QPainter *painter, const QRect &rect, const QList<qreal> &values, qreal max, const QColor &color)
+    {
+        if (values.size() < 2 || rect.width() <= 0)
+            return;
+
+        // Always spread over the full history length, so lines grow in from the right
+        const qreal step = qreal(rect.width()) / (ContainerStatsSampler::HISTORY_SIZE - 1);
+        QPolygonF line;
+        line.reserve(values.size());
+        qreal x = rect.right() - step * (values.size() - 1);
+        for (qreal value : values) {
+            line << QPointF(x, rect.bottom() - value / max * rect.height());
+            x += step;
+        }
+
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->setPen(QPen(color, 1.5));
+        painter->drawPolyline(line);
+    }
+};
+
+// Container list that explains itself while it is empty
+class ContainerListView : public QListView
+{
+public:
+    using QListView::QListView;
+
+protected:
+    void paintEvent(QPaintEvent *event) override
+    {
+        QListView::paintEvent(event);
+
+        auto *proxy = qobject_cast<QSortFilterProxyModel *>(model());
+        auto *containers = qobject_cast<ContainerListModel *>(proxy ? proxy->sourceModel() : model());
+        if (!containers || containers->rowCount() > 0)
+            return;
+
+        QPainter painter(viewport());
+        const QRect area = viewport()->rect().adjusted(0, 0, 0, -viewport()->height() / 3);
+        const QString text = containers->isLoading() ? i18n("Fetching containers...") : i18n("No containers found");
+
+        if (!containers->isLoading()) {
+            const int iconSize = 64;
+            const QRect iconRect(area.center().x() - iconSize / 2, area.center().y() - iconSize, iconSize, iconSize);
+            QIcon(":/icons/tux.svg").paint(&painter, iconRect);
+        }
+
+        QColor textColor = palette().text().color();
+        textColor.setAlpha(180);
+        painter.setPen(textColor);
+        painter.drawText(area.adjusted(0, 16, 0, 16), Qt::AlignCenter, text);
+    }
 };
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
-    // Show loading UI immediately
-    setupLoadingUI();
-
     backend = new Backend(this);
     connect(backend, &Backend::availableBackendsChanged, this, &MainWindow::onBackendsAvailable);
     connect(backend, &Backend::containersFetched, this, &MainWindow::handleContainersFetched);
-    connect(backend, &Backend::terminalFinished, this, &MainWindow::refreshContainers);
+    connect(backend, &Backend::terminalFinished, this, [this]() {
+        // With the event stream connected the list is already up to date
+        if (!backend->isWatchingContainers())
+            refreshContainers();
+    });
+    connect(backend->jobScheduler(), &JobScheduler::jobChanged, this, &MainWindow::updateJobsStatus);
+    connect(backend->statsSampler(), &ContainerStatsSampler::statsUpdated, this, [this](const QStringList &ids) {
+        if (!containerModel)
+            return;
+        for (const QString &id : ids) {
+            containerModel->setStats(id, backend->statsSampler()->history(id));
+        }
+    });
+    connect(backend->containerSizes(), &ContainerSizeCache::sizesChanged, this, [this](const QStringList &ids) {
+        if (!containerModel)
+            return;
+        for (const QString &id : ids) {
+            containerModel->setSizes(id, backend->containerSizes()->containerSize(id), backend->containerSizes()->imageSize(id));
+        }
+    });
+    updateStatsSampling();
+
+    // Show the containers seen last time right away, they are revalidated once the backends are known
+    const ContainerList snapshot = backend->loadContainerSnapshot();
+    if (snapshot.isEmpty()) {
+        setupLoadingUI();
+    } else {
+        setupUI();
+        containerModel->setStale(true);
+        containerModel->setLoading(true);
+        containerModel->setContainers(snapshot);
+    }
 
     setWindowTitle(tr("Kontainer"));
     resize(850, 600);
     setWindowIcon(QIcon::fromTheme("preferences-virtualization-container"));
 }
 
-void MainWindow::refreshContainers()
+void MainWindow::showEvent(QShowEvent *event)
 {
-    containerList->clear();
-
-    // Add inline spinner
-    QListWidgetItem *loadingItem = new QListWidgetItem(containerList);
-    containerList->addItem(loadingItem);
-
-    QWidget *loadingWidget = new QWidget();
-    QHBoxLayout *layout = new QHBoxLayout(loadingWidget);
-    layout->setContentsMargins(6, 6, 6, 6);
+    QMainWindow::showEvent(event);
+    updateStatsSampling();
+}
 
-    QLabel *label = new QLabel(i18n("Fetching containers..."));
-    QProgressBar *progress = new QProgressBar();
-    progress->setRange(0, 0); // Indeterminate
-    progress->setMaximumHeight(16);
-    progress->setTextVisible(false);
-    progress->setFixedWidth(100);
+void MainWindow::hideEvent(QHideEvent *event)
+{
+    QMainWindow::hideEvent(event);
+    updateStatsSampling();
+}
 
-    layout->addWidget(progress);
-    layout->addSpacing(10);
-    layout->addWidget(label);
-    layout->addStretch();
+void MainWindow::changeEvent(QEvent *event)
+{
+    QMainWindow::changeEvent(event);
+    if (event->type() == QEvent::WindowStateChange)
+        updateStatsSampling();
+}
 
-    loadingWidget->setLayout(layout);
+void MainWindow::applyContainerSorting(bool bySize)
+{
+    // Containers still being measured sort last, -1 stands for unknown
+    if (bySize)
+        containerProxy->sort(0, Qt::DescendingOrder);
+    else
+        containerProxy->sort(-1);
+}
 
-    containerList->setItemWidget(loadingItem, loadingWidget);
+void MainWindow::updateStatsSampling()
+{
+    backend->statsSampler()->setPaused(!isVisible() || isMinimized());
+}
 
+void MainWindow::refreshContainers()
+{
+    // The current rows stay in place until the new list arrives and is diffed in
+    containerModel->setLoading(true);
     backend->fetchContainersAsync();
 }
 
 // New slot to handle fetched containers
-void MainWindow::handleContainersFetched(const QList<QMap<QString, QString>> &containers)
+void MainWindow::handleContainersFetched(const ContainerList &containers)
 {
     qDebug() << "handleContainersFetched(): received" << containers.size() << "containers";
 
-    containerList->clear(); // removes spinner etc.
+    if (!containerModel)
+        return;
 
-    if (containers.isEmpty()) {
-        qDebug() << "No containers found. Adding placeholder with Tux icon.";
-        QListWidgetItem *item = new QListWidgetItem(i18n("No containers found"), containerList);
-        item->setFlags(item->flags() & ~Qt::ItemIsSelectable);
-        item->setData(Qt::UserRole + 5, QString(":/icons/tux.svg")); // Set icon path for delegate
-    } else {
-        for (const auto &container : containers) {
-            QListWidgetItem *item = new QListWidgetItem(container["name"], containerList);
-            item->setData(Qt::UserRole + 3, container["image"]);
-            item->setData(Qt::UserRole + 4, container["distro"]);
-            item->setData(Qt::UserRole + 5, container["icon"]);
-        }
-    }
+    containerModel->setContainers(containers);
+    containerModel->setLoading(false);
+    containerModel->setStale(false);
 
-    currentContainer.clear();
+    // Selection survives refreshes, unless the selected container is gone
+    const QModelIndexList selected = containerList->selectionModel()->selectedRows();
+    currentContainer = selected.isEmpty() ? QString() : selected.first().data(Qt::DisplayRole).toString();
     updateButtonStates();
 }
 
@@ -215,8 +361,12 @@ void MainWindow::onBackendsAvailable(const QStringList &backends)
         qApp->exit(1);
     }
 
-    // Now setup the full UI
-    setupUI();
+    // Now setup the full UI, unless the snapshot already brought it up
+    if (containerModel) {
+        updateBackendSelector();
+    } else {
+        setupUI();
+    }
     refreshContainers();
 }
 
@@ -233,14 +383,25 @@ void MainWindow::setupUI()
     mainLayout->setSpacing(12);
 
     // Left panel - Container list
-    containerList = new QListWidget(this);
+    containerModel = new ContainerListModel(this);
+    // Sizes arrive one container at a time, the proxy moves rows as they do
+    containerProxy = new QSortFilterProxyModel(this);
+    containerProxy->setSourceModel(containerModel);
+    containerProxy->setSortRole(ContainerListModel::SizeRole);
+    containerList = new ContainerListView(this);
+    containerList->setModel(containerProxy);
     containerList->setItemDelegate(new ContainerItemDelegate(this));
     containerList->setIconSize(QSize(32, 32));
     containerList->setSelectionMode(QAbstractItemView::SingleSelection);
     containerList->setAlternatingRowColors(true);
-    connect(containerList, &QListWidget::itemSelectionChanged, [this]() {
-        if (containerList->currentItem()) {
-            currentContainer = containerList->currentItem()->text();
+    // Every row has the same height, lets the view skip measuring each one
+    containerList->setUniformItemSizes(true);
+    containerList->setMouseTracking(true);
+    connect(containerModel, &ContainerListModel::loadingChanged, containerList->viewport(), qOverload<>(&QWidget::update));
+    connect(containerList->selectionModel(), &QItemSelectionModel::selectionChanged, this, [this]() {
+        const QModelIndexList selected = containerList->selectionModel()->selectedRows();
+        if (!selected.isEmpty()) {
+            currentContainer = selected.first().data(Qt::DisplayRole).toString();
             updateButtonStates();
         }
     });
@@ -331,6 +492,14 @@ void MainWindow::setupUI()
     connect(assembleBtn, &QToolButton::clicked, this, &MainWindow::assembleContainer);
     toolBar->addWidget(assembleBtn);
 
+    QToolButton *jobsBtn = new QToolButton(toolBar);
+    jobsBtn->setIcon(QIcon::fromTheme("view-list-details"));
+    jobsBtn->setText(i18n("Jobs"));
+    jobsBtn->setToolButtonStyle(Qt::ToolButtonTextBesideIcon);
+    jobsBtn->setToolTip(i18n("Show queued and running jobs"));
+    connect(jobsBtn, &QToolButton::clicked, this, &MainWindow::showJobsDialog);
+    toolBar->addWidget(jobsBtn);
+
     // Add expanding spacer between left and right sections
     QWidget *spacer = new QWidget();
     spacer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
@@ -348,9 +517,60 @@ void MainWindow::setupUI()
 
     addToolBar(Qt::TopToolBarArea, toolBar);
 
-    QComboBox *backendSelector = new QComboBox(toolBar);
-    QStringList availableBackends = backend->availableBackends();
-    QString currentBackend = backend->preferredBackend();
+    backendSelector = new QComboBox(toolBar);
+    updateBackendSelector();
+
+    connect(backendSelector, &QComboBox::currentIndexChanged, this, [=](int index) {
+        const QString filter = backendSelector->itemData(index).toString();
+        containerModel->setShowBackend(filter == Backend::AllBackends);
+        // The cached containers of the selection show up at once, the refresh only updates them
+        backend->setContainerFilter(filter);
+        upgradeBtn->setVisible(false);
+        refreshContainers();
+    });
+
+    toolBar->addWidget(backendSelector);
+
+    QComboBox *sortSelector = new QComboBox(toolBar);
+    sortSelector->addItem(QIcon::fromTheme("view-sort"), i18n("Default Order"), false);
+    sortSelector->addItem(QIcon::fromTheme("drive-harddisk"), i18n("Largest First"), true);
+    sortSelector->setToolTip(i18n("Order of the container list"));
+    const bool sortBySize = QSettings().value("container/sortBySize", false).toBool();
+    sortSelector->setCurrentIndex(sortBySize ? 1 : 0);
+    applyContainerSorting(sortBySize);
+    connect(sortSelector, &QComboBox::currentIndexChanged, this, [=](int index) {
+        const bool bySize = sortSelector->itemData(index).toBool();
+        QSettings().setValue("container/sortBySize", bySize);
+        applyContainerSorting(bySize);
+    });
+    toolBar->addWidget(sortSelector);
+
+    qDebug() << "Is a Terminal launch possible: " << hasTerminal;
+    qDebug() << "Preferred Backend:" << backend->preferredBackend();
+
+    mainLayout->addWidget(containerList, 1);
+    mainLayout->addWidget(rightPanel);
+    setCentralWidget(centralWidget);
+
+    // The terminal probe is cached by the backend, it only tells us when the result flips
+    connect(backend, &Backend::terminalAvailabilityChanged, this, [this](bool possible) {
+        hasTerminal = possible;
+        updateButtonStates();
+    });
+
+    updateButtonStates();
+}
+
+void MainWindow::updateBackendSelector()
+{
+    // Filling the selector must not switch backends
+    const QSignalBlocker blocker(backendSelector);
+    backendSelector->clear();
+
+    const QStringList availableBackends = backend->availableBackends();
+    if (availableBackends.size() > 1) {
+        backendSelector->addItem(QIcon::fromTheme("view-list-details"), i18n("All"), Backend::AllBackends);
+    }
 
     for (const QString &backendName : availableBackends) {
         QIcon icon;
@@ -363,30 +583,14 @@ void MainWindow::setupUI()
             icon = QIcon::fromTheme("system-run"); // fallback
         }
 
-        backendSelector->addItem(icon, backendName);
+        backendSelector->addItem(icon, backendName, backendName);
     }
 
-    int backendIndex = backendSelector->findText(currentBackend);
+    int backendIndex = backendSelector->findData(backend->containerFilter());
     if (backendIndex >= 0) {
         backendSelector->setCurrentIndex(backendIndex);
     }
-
-    connect(backendSelector, &QComboBox::currentTextChanged, this, [=](const QString &backendName) {
-        backend->setPreferredBackend(backendName);
-        upgradeBtn->setVisible(false);
-        refreshContainers();
-    });
-
-    toolBar->addWidget(backendSelector);
-
-    qDebug() << "Is a Terminal launch possible: " << hasTerminal;
-    qDebug() << "Preferred Backend:" << backend->preferredBackend();
-
-    mainLayout->addWidget(containerList, 1);
-    mainLayout->addWidget(rightPanel);
-    setCentralWidget(centralWidget);
-
-    updateButtonStates();
+    containerModel->setShowBackend(backend->containerFilter() == Backend::AllBackends);
 }
 
 void MainWindow::updateButtonStates()
@@ -397,7 +601,7 @@ void MainWindow::updateButtonStates()
     appsBtn->setEnabled(hasSelection);
     upgradeBtn->setEnabled(hasSelection);
 
-    if (backend->preferredBackend() == "toolbox") {
+    if (backend->backendFor(currentContainer) == "toolbox") {
         upgradeBtn->setVisible(false); // Upgrade selected container
     } else {
         upgradeBtn->setVisible(true);
@@ -479,9 +683,7 @@ void MainWindow::enterContainer()
 
 void MainWindow::assembleContainer()
 {
-    QString currentBackend = backend->preferredBackend();
-
-    if (currentBackend == "toolbox") {
+    if (backend->containerFilter() == "toolbox") {
         QMessageBox::information(this,
                                  i18n("Function Not Supported"),
                                  i18n("Toolbox backend doesn't support container assembly.\n\n"
@@ -500,21 +702,7 @@ void MainWindow::assembleContainer()
         if (iniFile.isEmpty())
             return;
 
-        // Clean up previous connections safely (if still connected)
-        disconnect(backend, &Backend::assembleStartedWithDialog, this, nullptr);
-        disconnect(backend, &Backend::assembleFinished, this, nullptr);
-
-        // Connect backend signals robustly
-        connect(backend, &Backend::assembleStartedWithDialog, this, [this]() {
-            setupProgressDialog(i18n("Assembling container..."));
-        });
-
-        connect(backend, &Backend::assembleFinished, this, [this](const QString &output) {
-            appendCommandOutput(output);
-        });
-
-        // Start backend logic
-        backend->assembleContainer(iniFile);
+        followJob(backend->assembleContainer(iniFile), i18n("Assembling container..."));
     });
 }
 
@@ -533,9 +721,7 @@ void MainWindow::setupProgressDialog(const QString &title)
     progressDialog->setWindowModality(Qt::WindowModal);
     progressDialog->setCancelButton(nullptr);
 
-    progressOutput = new QTextEdit(progressDialog);
-    progressOutput->setReadOnly(true);
-    progressOutput->setWordWrapMode(QTextOption::NoWrap);
+    progressOutput = new LogView(progressDialog);
 
     QVBoxLayout *layout = new QVBoxLayout(progressDialog);
     layout->addWidget(progressOutput);
@@ -559,17 +745,74 @@ void MainWindow::cleanupProgressDialog()
     }
 }
 
+// Shows a queued job's output in the progress dialog until it finishes
+void MainWindow::followJob(quint64 jobId, const QString &title)
+{
+    if (jobId == 0)
+        return;
+
+    setupProgressDialog(title);
+    if (backend->jobScheduler()->job(jobId).state == JobInfo::Queued) {
+        progressDialog->setLabelText(i18n("Waiting for other jobs on this container..."));
+    }
+
+    JobScheduler *scheduler = backend->jobScheduler();
+    progressDialog->setCancelButtonText(i18n("Cancel"));
+    connect(progressDialog, &QProgressDialog::canceled, scheduler, [scheduler, jobId]() {
+        scheduler->cancel(jobId);
+    });
+
+    connect(scheduler, &JobScheduler::jobChanged, progressDialog, [this, jobId](const JobInfo &job) {
+        if (job.id == jobId && job.state == JobInfo::Running)
+            progressDialog->setLabelText(i18n("Processing..."));
+    });
+    connect(scheduler, &JobScheduler::jobOutput, progressDialog, [this, jobId](quint64 id, const QString &chunk) {
+        if (id == jobId)
+            appendCommandOutput(chunk);
+    });
+    connect(scheduler, &JobScheduler::jobFinished, progressDialog, [this, jobId](const JobInfo &job, const CommandResult &result) {
+        if (job.id != jobId)
+            return;
+
+        if (result.success() || result.cancelled) {
+            cleanupProgressDialog();
+            return;
+        }
+
+        // Keep the output around so the failure can be read
+        progressDialog->setLabelText(i18n("Command failed with exit code %1", result.exitCode));
+        progressDialog->setCancelButtonText(i18n("Close"));
+        connect(progressDialog, &QProgressDialog::canceled, this, &MainWindow::cleanupProgressDialog);
+    });
+}
+
+void MainWindow::showJobsDialog()
+{
+    JobsDialog *dialog = new JobsDialog(backend->jobScheduler(), this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
+
+void MainWindow::updateJobsStatus()
+{
+    JobScheduler *scheduler = backend->jobScheduler();
+    const int running = scheduler->runningCount();
+    const int queued = scheduler->queuedCount();
+
+    if (running == 0 && queued == 0) {
+        statusBar()->clearMessage();
+        return;
+    }
+    statusBar()->showMessage(i18n("Jobs: %1 running, %2 queued", running, queued));
+}
+
 // New function to append output to the progress dialog
 void MainWindow::appendCommandOutput(const QString &output)
 {
     if (!progressOutput)
         return;
 
-    progressOutput->append(output);
-
-    QTextCursor cursor = progressOutput->textCursor();
-    cursor.movePosition(QTextCursor::End);
-    progressOutput->setTextCursor(cursor);
+    progressOutput->appendOutput(output);
 }
 
 void MainWindow::installDebPackage()
@@ -593,16 +836,7 @@ void MainWindow::installDebPackage()
 
     if (!backend->isTerminalJobPossible()) {
         qDebug() << "[installDebPackage] Using internal install.";
-        setupProgressDialog(i18n("Installing .deb package..."));
-
-        connect(backend, &Backend::outputReceived, this, &MainWindow::appendCommandOutput);
-        connect(backend, &Backend::debInstallFinished, this, [this](const QString &output) {
-            appendCommandOutput(output);
-            cleanupProgressDialog();
-            disconnect(backend, nullptr, this, nullptr);
-        });
-
-        backend->installDebPackageNoTerminal(currentContainer, filePath);
+        followJob(backend->installDebPackageNoTerminal(currentContainer, filePath), i18n("Installing .deb package..."));
     } else {
         qDebug() << "[installDebPackage] Using terminal backend.";
         connect(backend, &Backend::debInstallFinished, this, [](const QString &) {});
@@ -631,16 +865,7 @@ void MainWindow::installRpmPackage()
 
     if (!backend->isTerminalJobPossible()) {
         qDebug() << "[installRpmPackage] Using internal install.";
-        setupProgressDialog(i18n("Installing .rpm package..."));
-
-        connect(backend, &Backend::outputReceived, this, &MainWindow::appendCommandOutput);
-        connect(backend, &Backend::rpmInstallFinished, this, [this](const QString &output) {
-            appendCommandOutput(output);
-            cleanupProgressDialog();
-            disconnect(backend, nullptr, this, nullptr);
-        });
-
-        backend->installRpmPackageNoTerminal(currentContainer, filePath);
+        followJob(backend->installRpmPackageNoTerminal(currentContainer, filePath), i18n("Installing .rpm package..."));
     } else {
         qDebug() << "[installRpmPackage] Using terminal backend.";
         connect(backend, &Backend::rpmInstallFinished, this, [](const QString &) {});
@@ -669,16 +894,7 @@ void MainWindow::installArchPackage()
 
     if (!backend->isTerminalJobPossible()) {
         qDebug() << "[installArchPackage] Using internal install.";
-        setupProgressDialog(i18n("Installing Arch package..."));
-
-        connect(backend, &Backend::outputReceived, this, &MainWindow::appendCommandOutput);
-        connect(backend, &Backend::archInstallFinished, this, [this](const QString &output) {
-            appendCommandOutput(output);
-            cleanupProgressDialog();
-            disconnect(backend, nullptr, this, nullptr);
-        });
-
-        backend->installArchPackageNoTerminal(currentContainer, filePath);
+        followJob(backend->installArchPackageNoTerminal(currentContainer, filePath), i18n("Installing Arch package..."));
     } else {
         qDebug() << "[installArchPackage] Using terminal backend.";
         connect(backend, &Backend::archInstallFinished, this, [](const QString &) {});
@@ -697,16 +913,7 @@ void MainWindow::upgradeContainer()
 
     if (!backend->isTerminalJobPossible()) {
         qDebug() << "[upgradeContainer] Using internal upgrade.";
-        setupProgressDialog(i18n("Upgrading container..."));
-
-        connect(backend, &Backend::outputReceived, this, &MainWindow::appendCommandOutput);
-        connect(backend, &Backend::upgradeFinished, this, [this](const QString &output) {
-            appendCommandOutput(output);
-            cleanupProgressDialog();
-            disconnect(backend, nullptr, this, nullptr);
-        });
-
-        backend->upgradeContainerNoTerminal(currentContainer);
+        followJob(backend->upgradeContainerNoTerminal(currentContainer), i18n("Upgrading container..."));
     } else {
         qDebug() << "[upgradeContainer] Using terminal backend.";
         connect(backend, &Backend::upgradeFinished, this, [](const QString &) {});
@@ -719,16 +926,15 @@ void MainWindow::upgradeAllContainers()
     qDebug() << "[upgradeAllContainers] Called";
 
     if (!backend->isTerminalJobPossible()) {
-        setupProgressDialog(i18n("Upgrading all containers..."));
-
-        connect(backend, &Backend::outputReceived, this, &MainWindow::appendCommandOutput);
-        connect(backend, &Backend::upgradeAllFinished, this, [this](const QString &output) {
-            appendCommandOutput(output);
-            cleanupProgressDialog();
-            disconnect(backend, nullptr, this, nullptr);
-        });
+        const QList<quint64> jobIds = backend->upgradeAllContainersNoTerminal();
+        if (jobIds.size() == 1) {
+            followJob(jobIds.first(), i18n("Upgrading all containers..."));
+            return;
+        }
 
-        backend->upgradeAllContainersNoTerminal();
+        JobProgressDialog *dialog = new JobProgressDialog(backend->jobScheduler(), jobIds, this);
+        dialog->setAttribute(Qt::WA_DeleteOnClose);
+        dialog->show();
     } else {
         connect(backend, &Backend::upgradeAllFinished, this, [](const QString &) {});
         backend->upgradeAllContainers();
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: GPL-2.0-only OR LicenseRef-KDE-Accepted-GPL
+// SPDX-FileCopyrightText: 2025 Hadi Chokr <hadichokr@icloud.com>
+
+#include "outputsink.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSettings>
+
+OutputSink::OutputSink(QObject *parent)
+    : OutputSink(defaultCapacity(), parent)
+{
+}
+
+OutputSink::OutputSink(qsizetype capacity, QObject *parent)
+    : QObject(parent)
+    , m_capacity(qMax<qsizetype>(1024, capacity))
+{
+}
+
+qsizetype OutputSink::defaultCapacity()
+{
+    QSettings settings;
+    return settings.value("jobs/outputBufferSize", 256 * 1024).toLongLong();
+}
+
+qsizetype OutputSink::capacity() const
+{
+    return m_capacity;
+}
+
+void OutputSink::setSpillToDisk(bool spill)
+{
+    m_spillToDisk = spill;
+}
+
+void OutputSink::append(const QString &chunk)
+{
+    if (chunk.isEmpty())
+        return;
+
+    m_size += chunk.size();
+
+    if (m_logFile) {
+        m_logFile->write(chunk.toUtf8());
+    } else if (m_size > m_capacity && m_spillToDisk && !m_spillFailed) {
+        spill();
+        if (m_logFile)
+            m_logFile->write(chunk.toUtf8());
+    }
+
+    m_buffer += chunk;
+    if (m_buffer.size() - m_start > m_capacity) {
+        m_start = m_buffer.size() - m_capacity;
+    }
+
+    // Drop the stale head once it outgrows the tail, so appends stay amortized O(1)
+    if (m_start > m_capacity) {
+        m_buffer.remove(0, m_start);
+        m_start = 0;
+    }
+}
+
+QString OutputSink::tail() const
+{
+    return m_buffer.mid(m_start);
+}
+
+qsizetype OutputSink::size() const
+{
+    return m_size;
+}
+
+bool OutputSink::isTruncated() const
+{
+    return m_size > m_buffer.size() - m_start;
+}
+
+QString OutputSink::logFilePath() const
+{
+    return m_logFile ? m_logFile->fileName() : QString();
+}
+
+QString OutputSink::readAll() const
+{
+    if (!m_logFile)
+        return tail();
+
+    m_logFile->flush();
+    QFile log(m_logFile->fileName());
+    if (!log.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not read back output log" << log.fileName() << ":" << log.errorString();
+        return tail();
+    }
+    return QString::fromUtf8(log.readAll());
+}
+
+void OutputSink::spill()
+{
+    m_logFile = new QTemporaryFile(QDir::tempPath() + "/kontainer-XXXXXX.log", this);
+    if (!m_logFile->open()) {
+        qWarning() << "Could not create output log, keeping only the tail:" << m_logFile->errorString();
+        delete m_logFile;
+        m_logFile = nullptr;
+        m_spillFailed = true;
+        return;
+    }
+
+    // Nothing has been dropped yet, so the buffer still holds everything written so far
+    m_logFile->write(m_buffer.mid(m_start).toUtf8());
+}